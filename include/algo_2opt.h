@@ -2,7 +2,14 @@
 #define ALGO_2OPT_H
 
 #include "tsp_types.h"
+#include "solve_ctx.h"
 
-int improve_2opt(const TSP_Instance *inst, int *tour);
+// ctx (peut être NULL) : arrêt entre deux lignes de balayage, la tournée reste valide.
+// Chaque mouvement appliqué est signalé à ctx (progression).
+int improve_2opt(const TSP_Instance *inst, int *tour, Solve_Context *ctx);
+
+// Variante retournant le gain total (diminution de longueur) obtenu ; ne signale rien,
+// l'appelant (GA, nnms, rw) connaît la longueur et décide de ce qui est une meilleure tournée
+double improve_2opt_gain(const TSP_Instance *inst, int *tour, Solve_Context *ctx);
 
 #endif
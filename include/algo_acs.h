@@ -0,0 +1,21 @@
+#ifndef ALGO_ACS_H
+#define ALGO_ACS_H
+
+#include "tsp_types.h"
+#include "solve_ctx.h"
+
+#define ACS_BUDGET_DEFAUT 1.0   // secondes, sans budget ni échéance
+
+// Ant Colony System (Dorigo & Gambardella) : les phéromones ne sont stockées que sur les
+// arêtes vers les k plus proches voisins (tableau plat n * k, mémoire linéaire en n), une
+// fourmi choisit parmi ses candidats libres (repli sur la ville libre la plus proche) :
+// construction en O(n * k) par fourmi. Les fourmis d'une itération sont construites en
+// parallèle sur nb_threads threads, chacune avec son propre flux aléatoire (résultat
+// indépendant du nombre de threads). with_2opt : la meilleure fourmi de chaque itération
+// passe au 2-opt avant la mise à jour globale.
+// Arrêt après time_budget secondes (<= 0 : échéance de ctx, sinon ACS_BUDGET_DEFAUT).
+// seed : graine des flux aléatoires (0 : dérivée de l'horloge).
+int* acs_tour(const TSP_Instance *inst, double time_budget, int nb_threads, int with_2opt,
+              unsigned long long seed, Solve_Context *ctx);
+
+#endif
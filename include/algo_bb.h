@@ -0,0 +1,15 @@
+#ifndef ALGO_BB_H
+#define ALGO_BB_H
+
+#include "tsp_types.h"
+#include "solve_ctx.h"
+#include "checkpoint.h"
+
+// Solveur exact par séparation et évaluation (branch-and-bound).
+// Retourne la tournée optimale (avec retour au point de départ), ou la meilleure
+// trouvée si la recherche est arrêtée par ctx (annulation, échéance, Ctrl-C).
+// cp (NULL : aucune sauvegarde) : préfixe courant et meilleure tournée sont sauvegardés
+// périodiquement et à l'arrêt ; la reprise saute directement au préfixe sauvegardé.
+int* bb_tour(const TSP_Instance *inst, Solve_Context *ctx, const Checkpoint_Options *cp);
+
+#endif
@@ -1,7 +1,13 @@
 #ifndef BRUTE_FORCE_H
 #define BRUTE_FORCE_H
 
+#include <stdbool.h>
+#include <stddef.h>
 
+// Recherche exhaustive générique sur les permutations de 0..nb_nodes-1.
+// nb_ressources : nombre de threads de calcul (<= 1 : séquentiel). En parallèle,
+// cout est appelée simultanément depuis plusieurs threads et doit être réentrante.
+// cout retourne un unsigned long long alloué par malloc (libéré par brute), ou NULL.
 double brute(
     int nb_nodes,
     int nb_ressources,
@@ -10,4 +16,66 @@ double brute(
     void *(*cout)(void *, int *)
 );
 
+// Valeur renvoyée par un hook pour couper la branche courante
+#define BF_INFEASIBLE (~0ULL)
+
+// API incrémentale : aucun appel n'alloue. Le coût d'une permutation est la somme
+// des extend successifs plus close. Tous les hooks sauf extend sont facultatifs (NULL).
+// Les coûts étant positifs, un préfixe plus cher que la meilleure solution est élagué.
+typedef struct {
+    // Coût ajouté en plaçant perm[pos] derrière perm[0..pos-1], ou BF_INFEASIBLE
+    unsigned long long (*extend)(void *ctx, const int *perm, int pos);
+    // perm[pos] va être retiré du préfixe (appelé après chaque extend accepté)
+    void (*retract)(void *ctx, const int *perm, int pos);
+    // Coût ajouté une fois la permutation complète, ou BF_INFEASIBLE
+    unsigned long long (*close)(void *ctx, const int *perm, int n);
+    // Minorant du coût restant (extensions + close) une fois perm[0..pos] placé ;
+    // used[v] indique les éléments déjà placés
+    unsigned long long (*lower_bound)(void *ctx, const int *perm, int pos, const bool *used);
+    // Arrêt demandé par l'appelant (annulation, échéance), en plus de Ctrl-C ;
+    // consulté tous les BF_PERIODE_ARRET nœuds, la meilleure permutation trouvée est rendue
+    int (*stop)(void *ctx);
+} BF_Hooks;
+
+#define BF_PERIODE_ARRET 1024
+
+// Même contrat que brute() ; ctx est transmis tel quel aux hooks. En parallèle, ctx est
+// partagé par tous les threads : les hooks doivent alors être réentrants (retract ne
+// peut donc servir qu'à un état propre au thread ou en séquentiel).
+double brute_incr(
+    int nb_nodes,
+    int nb_ressources,
+    int *best_perm,
+    unsigned long long *count_best,
+    const BF_Hooks *hooks,
+    void *ctx
+);
+
+// Sauvegarde de la recherche : l'arbre est découpé en tâches racines (préfixes de longueur
+// fixe, indépendante du nombre de threads) ; l'état est la liste des racines entièrement
+// explorées et la meilleure permutation. Le moteur ne fait aucune entrée/sortie : save
+// reçoit l'état à écrire, reprise est un état rendu par un save précédent.
+typedef struct {
+    double periode;             // secondes entre deux appels à save (<= 0 : 60)
+    int (*save)(void *user, const void *etat, size_t taille);
+    const void *reprise;        // NULL : départ de zéro
+    size_t reprise_taille;
+    void *user;
+    int repris;                 // sortie : 1 si reprise était compatible et a été repris
+} BF_Checkpoint;
+
+// brute_incr avec sauvegarde (cp NULL : identique à brute_incr). save est appelé depuis un
+// thread de calcul (jamais deux fois en même temps) au plus toutes les periode secondes, et
+// une dernière fois en fin de recherche, arrêtée ou non. Une reprise rend le même résultat
+// qu'une recherche ininterrompue, quel que soit le nombre de threads de chaque exécution.
+double brute_incr_cp(
+    int nb_nodes,
+    int nb_ressources,
+    int *best_perm,
+    unsigned long long *count_best,
+    const BF_Hooks *hooks,
+    void *ctx,
+    BF_Checkpoint *cp
+);
+
 #endif // BRUTE_FORCE_H
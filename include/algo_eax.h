@@ -0,0 +1,21 @@
+#ifndef ALGO_EAX_H
+#define ALGO_EAX_H
+
+#include "tsp_types.h"
+
+// Espace de travail de l'EAX (alloué une fois par exécution du GA)
+typedef struct EAX_Workspace EAX_Workspace;
+
+EAX_Workspace *eax_create(const TSP_Instance *inst);
+void eax_free(EAX_Workspace *ws);
+
+// Tournée initiale : plus proche voisin sur les listes de candidats, départ aléatoire.
+// Les AB-cycles entre tours aléatoires couvrent presque toutes les arêtes : l'EAX
+// converge bien plus vite depuis une population de tours déjà raisonnables.
+void eax_init_tour(EAX_Workspace *ws, int *perm);
+
+// Edge Assembly Crossover : construit child (permutation de 0..n-1) à partir de pa et pb.
+// Retourne la longueur de child. len_a est la longueur de pa (déjà connue du GA).
+double eax_crossover(EAX_Workspace *ws, const int *pa, double len_a, const int *pb, int *child);
+
+#endif
@@ -2,7 +2,47 @@
 #define ALGO_GA_H
 
 #include "tsp_parser.h"  
+#include "solve_ctx.h"
+#include "checkpoint.h"
 
-int* ga_tour(const TSP_Instance *inst, int pop_size, int generations, double mutation_rate, int use_dpx);
+// Opérateur de croisement utilisé par ga_tour
+typedef enum {
+    GA_CROSS_OX  = 0,   // Ordered Crossover
+    GA_CROSS_DPX = 1,   // Distance Preserving Crossover + 2-opt (mémétique)
+    GA_CROSS_EAX = 2,   // Edge Assembly Crossover (sans mutation : mut ignoré)
+    GA_CROSS_GPX = 3    // Generalized Partition Crossover + 2-opt (mémétique, mut ignoré)
+} GA_Crossover;
+
+// Opérateur de mutation (appliqué à chaque gène avec la probabilité mutation_rate)
+typedef enum {
+    GA_MUT_SWAP      = 0,   // échange de deux villes
+    GA_MUT_INVERSION = 1,   // inversion d'un segment
+    GA_MUT_INSERTION = 2    // déplacement d'une ville
+} GA_Mutation;
+
+// Suivi de convergence (facultatif)
+typedef struct {
+    const char *trace_file; // trace CSV par génération : meilleur, moyenne, pire, diversité, temps
+    int stagnation;         // arrêt après N générations sans amélioration (<= 0 : jamais)
+    // Sauvegarde (NULL : aucune) : population, meilleur individu, génération et état du
+    // générateur, écrits entre deux générations et à l'arrêt. La reprise continue à
+    // l'identique (pop, croisement, mutation et taux doivent être ceux de la sauvegarde ;
+    // gen peut être augmenté pour prolonger une exécution terminée).
+    const Checkpoint_Options *checkpoint;
+} GA_Suivi;
+
+// Générateur pseudo-aléatoire du GA et de l'EAX : état propre au thread appelant,
+// deux résolutions concurrentes (bibliothèque, daemon) ne se perturbent pas
+int ga_rand(void);
+
+// seed : graine du générateur pseudo-aléatoire (0 : dérivée de l'horloge)
+int* ga_tour(const TSP_Instance *inst, int pop_size, int generations, double mutation_rate,
+             int crossover, int mutation, unsigned int seed);
+
+// Variante avec suivi de convergence (suivi peut être NULL) et contexte de résolution
+// (NULL : Ctrl-C seulement) ; arrêtée, retourne le meilleur individu des générations complètes
+int* ga_tour_suivi(const TSP_Instance *inst, int pop_size, int generations, double mutation_rate,
+                   int crossover, int mutation, unsigned int seed, const GA_Suivi *suivi,
+                   Solve_Context *ctx);
 
 #endif
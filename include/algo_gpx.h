@@ -0,0 +1,28 @@
+#ifndef ALGO_GPX_H
+#define ALGO_GPX_H
+
+#include "tsp_types.h"
+
+// Generalized Partition Crossover (Whitley, Hains, Howe) : les arêtes propres à l'un des
+// deux parents forment des composantes connexes ; une composante reliée au reste par
+// exactement deux arêtes communes est parcourue par chaque parent en un seul chemin
+// entre les mêmes extrémités, on y garde le plus court. L'enfant n'est jamais plus long
+// que le meilleur parent ; tout est en O(n).
+
+// Espace de travail (tableaux de n villes), alloué une fois par utilisateur
+typedef struct GPX_Workspace GPX_Workspace;
+
+GPX_Workspace *gpx_create(int n);
+void gpx_free(GPX_Workspace *ws);
+
+// Croise pa et pb (permutations de 0..n-1, longueurs len_a et len_b) dans child
+// (permutation, peut être pa ou pb) ; retourne la longueur de child
+double gpx_crossover(GPX_Workspace *ws, const TSP_Instance *inst, const int *pa, double len_a,
+                     const int *pb, double len_b, int *child);
+
+// Fusionne nb tournées : la meilleure est croisée tour à tour avec chacune des autres,
+// jusqu'à ce qu'une passe n'améliore plus rien. Retourne la tournée fermée (n + 1 villes),
+// au moins aussi courte que la meilleure des tournées fournies ; NULL si erreur
+int *gpx_merge(const TSP_Instance *inst, const int *const *tours, int nb);
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef ALGO_HK_H
+#define ALGO_HK_H
+
+#include "tsp_types.h"
+#include "solve_ctx.h"
+
+// Nombre maximal de villes accepté par Held-Karp (mémoire en (n-1) * 2^(n-2) * 5 octets)
+#define HK_MAX_VILLES 25
+
+// Solveur exact par programmation dynamique de Held-Karp, O(n² 2ⁿ).
+// Retourne la tournée optimale (avec retour au point de départ), NULL si n > HK_MAX_VILLES
+// ou si la mémoire manque. Arrêtée par ctx (annulation, échéance, Ctrl-C), retourne une
+// tournée NN + 2-opt.
+int* hk_tour(const TSP_Instance *inst, Solve_Context *ctx);
+
+#endif
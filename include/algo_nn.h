@@ -2,8 +2,19 @@
 #define ALGO_NN_H
 
 #include "tsp_types.h"
+#include "solve_ctx.h"
 
-int* nn_tour(const TSP_Instance *inst);             // retourne la tournée (avec retour au point de départ)
+// Retourne la tournée (avec retour au point de départ). Arrêtée par ctx (NULL : Ctrl-C
+// seulement), la tournée est complétée par les villes restantes dans l'ordre des indices.
+int* nn_tour(const TSP_Instance *inst, Solve_Context *ctx);
 double tour_length(const TSP_Instance *inst, int *tour); // calcule la longueur totale
 
+// NN multi-départs : construit une tournée depuis nb_departs villes (<= 0 : toutes,
+// sinon échantillon régulier) sur nb_threads threads. Une tournée partielle est
+// abandonnée dès qu'elle dépasse la k-ième meilleure tournée complète.
+// top_k > 0 : les top_k meilleures tournées passent au 2-opt, puis sont fusionnées par GPX
+// (algo_gpx.h) en une tournée au moins aussi courte que la meilleure.
+// Arrêtée par ctx, retourne la meilleure tournée déjà construite.
+int* nn_multistart(const TSP_Instance *inst, int nb_departs, int nb_threads, int top_k, Solve_Context *ctx);
+
 #endif
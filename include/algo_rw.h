@@ -2,7 +2,19 @@
 #define ALGO_RW_H
 
 #include "tsp_types.h"
+#include "solve_ctx.h"
 
-int* rw_tour(const TSP_Instance *inst);
+int* rw_tour(const TSP_Instance *inst);             // une tournée aléatoire (avec retour au départ)
+
+// Échantillonnage aléatoire : tire nb_samples tournées (<= 0 : illimité) ou s'arrête après
+// time_budget secondes (<= 0 : pas de limite), sur nb_threads threads ayant chacun leur
+// propre flux aléatoire, et retourne la meilleure. with_2opt : chaque tirage passe au 2-opt
+// (redémarrages aléatoires) et chaque optimum local est fusionné par GPX dans la meilleure
+// tournée du thread, puis celles des threads entre elles. Si aucune limite n'est donnée,
+// un seul tirage est fait.
+// seed : graine commune des flux (0 : dérivée de l'horloge).
+// ctx : arrêt (annulation, échéance) vérifié à chaque lot de tirages et après chaque 2-opt.
+int* rw_sample(const TSP_Instance *inst, long long nb_samples, double time_budget,
+               int nb_threads, int with_2opt, unsigned long long seed, Solve_Context *ctx);
 
 #endif
@@ -0,0 +1,19 @@
+#ifndef ALGO_SA_H
+#define ALGO_SA_H
+
+#include "tsp_types.h"
+#include "solve_ctx.h"
+
+#define SA_BUDGET_DEFAUT 1.0    // secondes, sans budget ni échéance
+
+// Recuit simulé : mouvements 2-opt et Or-opt (segments de 1 à 3 villes) vers les k plus
+// proches voisins, variation de longueur en O(1), acceptation par exponentielle approchée.
+// La température décroît géométriquement avec le temps écoulé sur time_budget secondes
+// (<= 0 : échéance de ctx, sinon SA_BUDGET_DEFAUT) : plus de temps donne une meilleure tournée.
+// nb_threads > 1 : recuit parallèle avec échange de répliques (parallel tempering), chaque
+// thread fait évoluer une tournée sur une échelle de températures.
+// seed : graine des flux aléatoires (0 : dérivée de l'horloge).
+int* sa_tour(const TSP_Instance *inst, double time_budget, int nb_threads, unsigned long long seed,
+             Solve_Context *ctx);
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "solver.h"
+
+// Plafond par défaut de la mémoire occupée par les instances chargées simultanément
+#define BATCH_MEM_DEFAUT_MO 1024
+
+// Mode batch : chaque ligne de jobs_file est "<fichier.tsp> <méthode> [pop gen mut]"
+// ("all" développe les six méthodes de -m all ; lignes vides et # ignorées).
+// Chaque instance est lue une seule fois ; les jobs sont répartis sur nb_workers threads,
+// sans dépasser mem_max octets d'instances résidentes (une instance seule passe toujours).
+// Les résultats sont ajoutés à csv_file (si non NULL) au fil de l'eau ; borne = 0 : pas
+// de borne de Held-Karp (colonnes lb et gap à 0).
+// Retourne 1 si tous les jobs ont abouti, 0 sinon.
+int batch_run(const char *jobs_file, const char *csv_file, const Solver_Params *defaults,
+              int nb_workers, double mem_max, int borne);
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include "solver.h"
+
+#define BENCH_REPETITIONS 5
+#define BENCH_METHODES "nn,nnms,nn2opt,nnms2opt,rw2opt,gadpx"
+#define BENCH_CORPUS "tests/data"
+
+// Paramètres GA par défaut (remplacés par -bga)
+#define BENCH_GA_POP 50
+#define BENCH_GA_GEN 100
+#define BENCH_GA_MUT 0.05
+
+// Options du mode --bench
+typedef struct {
+    int repetitions;            // mesures par couple (instance, méthode)
+    int warmup;                 // exécutions d'échauffement, non mesurées
+    unsigned int seed;          // graine de base : la répétition i utilise seed + i
+    const char *methodes;       // liste séparée par des virgules
+    const char **corpus;        // fichiers .tsp et/ou répertoires (tous leurs *.tsp)
+    int nb_corpus;
+    const char *csv_file;       // NULL : pas d'export CSV
+    const char *json_file;      // NULL : pas d'export JSON
+} Bench_Options;
+
+// Mesure chaque méthode sur chaque instance du corpus : min / médiane / p95 du temps
+// (réel) et de la longueur, écart à l'optimum connu. Retourne 0 si succès.
+int bench_run(const Bench_Options *opt, const Solver_Params *params);
+
+#endif
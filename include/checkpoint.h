@@ -0,0 +1,40 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "tsp_types.h"
+
+// Sauvegardes périodiques des longues résolutions (ga, gadpx, gaeax, gagpx, bf, bfenum) et reprise.
+// Fichier : "TSPC", type sur 4 caractères, taille (uint64), état, somme de contrôle FNV-1a.
+// L'état est écrit dans l'ordre des octets de la machine : reprise sur la même architecture.
+
+#define CHECKPOINT_PERIODE_DEFAUT 60.0  // secondes entre deux sauvegardes
+
+typedef struct {
+    const char *file;       // NULL : pas de sauvegarde
+    double periode;         // secondes entre deux sauvegardes (<= 0 : CHECKPOINT_PERIODE_DEFAUT)
+    int reprise;            // 1 : reprendre depuis file s'il existe (--resume)
+} Checkpoint_Options;
+
+// Écriture atomique : <file>.tmp est écrit et synchronisé puis renommé en file ;
+// une interruption pendant l'écriture laisse la sauvegarde précédente intacte. 0 si succès
+int checkpoint_write(const char *file, const char type[4], const void *data, size_t len);
+
+// État d'une sauvegarde du type attendu (à libérer), NULL si absente, d'un autre type ou corrompue
+void *checkpoint_read(const char *file, const char type[4], size_t *len);
+
+// Empreinte d'une instance (dimension, type de distance, coordonnées) : une sauvegarde
+// n'est reprise que sur la même instance
+uint64_t checkpoint_signature(const TSP_Instance *inst);
+
+// Lecture séquentielle d'un état
+typedef struct {
+    const unsigned char *p;
+    size_t reste;
+} Checkpoint_Reader;
+
+// Copie les len octets suivants dans dst ; 0 si l'état est trop court
+int checkpoint_get(Checkpoint_Reader *r, void *dst, size_t len);
+
+#endif
@@ -1,14 +1,27 @@
 #ifndef CSV_EXPORT_H
 #define CSV_EXPORT_H
 
+#include "tour_io.h"
+
+#define CSV_ENTETE_RESUME "instance;méthode;durée(s);longueur;borne_inf;ecart;tournee\n"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+// Tournée seule : "position;ville", une ligne par ville (n + 1 lignes, retour au départ)
 int export_tour_csv(const char *filename, const int *tour, int n);
 
+// Ligne du CSV de résumé (précédée de l'entête si entete) ajoutée à b, sans écriture :
+// permet de regrouper plusieurs lignes en une seule écriture. lower_bound <= 0 : pas de
+// borne, champs borne_inf et ecart vides
+void summary_csv_format(Tour_Buffer *b, const char *instance_name, const char *method,
+                        double duration_sec, double cost, double lower_bound,
+                        const int *tour, int n, int entete);
+
 int export_summary_csv(const char *filename, const char *instance_name, const char *method,
-                       double duration_sec, double cost, const int *tour, int n, int entete);
+                       double duration_sec, double cost, double lower_bound,
+                       const int *tour, int n, int entete);
                        
 #ifdef __cplusplus
 }
@@ -0,0 +1,28 @@
+#ifndef DECOMPOSE_H
+#define DECOMPOSE_H
+
+#include "tsp_types.h"
+#include "solve_ctx.h"
+#include "solver.h"
+
+#define DC_TAILLE_DEFAUT 500    // villes par cluster au plus
+
+// Décomposition géométrique pour les très grandes instances (option -dc) :
+// 1. partition récursive de Karp : la boîte englobante est coupée à la médiane de son
+//    plus grand côté jusqu'à des clusters d'au plus taille_cluster villes ;
+// 2. chaque cluster devient une sous-instance (matrice taille_cluster², jamais n²) résolue
+//    par la méthode methode avec les paramètres p (mono-thread), en parallèle sur
+//    nb_threads threads ;
+// 3. les cycles sont fusionnés dans l'ordre de Hilbert des centres des clusters : chaque
+//    nouveau cycle est rattaché par l'échange de deux arêtes le moins coûteux parmi celles
+//    des villes proches de la frontière avec le cluster précédent ;
+// 4. une fenêtre de tournée autour de chaque arête de jonction est réoptimisée (2-opt et
+//    Or-opt à extrémités fixes), fenêtres disjointes traitées en parallèle.
+// inst peut être sans matrice (tsp_read_coords) : les distances hors clusters sont
+// calculées depuis les coordonnées. ctx : échéance et annulation partagées par toutes
+// les sous-résolutions ; un cluster commencé après l'arrêt reçoit sa tournée NN.
+// Retourne la tournée fermée (n + 1 villes) ou NULL.
+int *decompose_solve(const TSP_Instance *inst, const char *methode, const Solver_Params *p,
+                     int taille_cluster, int nb_threads, Solve_Context *ctx);
+
+#endif
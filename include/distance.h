@@ -14,6 +14,10 @@ DistanceType parse_distance_type(const char *s);
 // en fonction de inst->dist_type (EUC_2D, ATT, GEO).
 void build_distance_matrix(TSP_Instance *inst);
 
+// Distance entre i et j : lue dans inst->dist si la matrice existe, sinon calculée
+// à partir des coordonnées (instances trop grandes pour une matrice, voir decompose.h)
+double distance_ij(const TSP_Instance *inst, int i, int j);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,28 @@
+#ifndef GA_TRACE_H
+#define GA_TRACE_H
+
+// Trace de convergence du GA : une ligne par génération, écrite en CSV par un thread
+// dédié. Le GA dépose les lignes dans un anneau préalloué sans jamais attendre
+// d'entrée-sortie ; si l'anneau est plein, la ligne est perdue (et comptée).
+
+typedef struct {
+    int generation;
+    double best;            // meilleure longueur de la population
+    double mean;            // longueur moyenne
+    double worst;           // pire longueur
+    double diversity;       // proportion de tournées distinctes (0..1]
+    double elapsed;         // secondes depuis le début du GA
+} GA_Trace_Entry;
+
+typedef struct GA_Trace GA_Trace;
+
+// Ouvre le fichier et démarre l'écrivain ; NULL en cas d'échec
+GA_Trace *ga_trace_open(const char *filename, int capacity);
+
+// Dépose une ligne sans bloquer (un seul producteur)
+void ga_trace_push(GA_Trace *t, const GA_Trace_Entry *e);
+
+// Vide l'anneau, arrête l'écrivain et ferme le fichier
+void ga_trace_close(GA_Trace *t);
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef HASH_H
+#define HASH_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// FNV-1a 64 bits : empreintes d'instances (démon) et sommes de contrôle (sauvegardes).
+// Les appels se chaînent : h = fnv1a(fnv1a(FNV_INIT, a, la), b, lb).
+#define FNV_INIT 0xCBF29CE484222325ULL
+
+static inline uint64_t fnv1a(uint64_t h, const void *data, size_t len) {
+    const unsigned char *p = data;
+    for (size_t i = 0; i < len; ++i) {
+        h ^= p[i];
+        h *= 0x100000001B3ULL;
+    }
+    return h;
+}
+
+#endif
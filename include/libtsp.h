@@ -0,0 +1,105 @@
+#ifndef LIBTSP_H
+#define LIBTSP_H
+
+// API C de libtsp.so (make lib) : chargement d'instances, méthodes de résolution,
+// évaluation et export de tournées. Aucun état global : tout passe par les arguments,
+// deux appels sur des instances distinctes peuvent s'exécuter en parallèle et une même
+// instance peut être résolue par plusieurs threads à la fois (lecture seule).
+// Les villes sont numérotées de 0 à n-1 ; une tournée est une permutation de n villes.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(__GNUC__)
+#define LIBTSP_API __attribute__((visibility("default")))
+#else
+#define LIBTSP_API
+#endif
+
+#define LIBTSP_VERSION 1
+
+// Codes de retour
+#define LIBTSP_OK            0
+#define LIBTSP_ERR_ARG      -1  // argument invalide (pointeur NULL, dimension, tampon)
+#define LIBTSP_ERR_METHOD   -2  // méthode inconnue
+#define LIBTSP_ERR_PARAM    -3  // paramètre inconnu ou manquant (pop gen mut pour ga, gadpx, gaeax, gagpx)
+#define LIBTSP_ERR_SOLVE    -4  // échec de la résolution (mémoire, interruption)
+#define LIBTSP_ERR_IO       -5  // fichier illisible ou impossible à écrire
+
+// Instance opaque (coordonnées + matrice des distances)
+typedef struct LibTSP_Instance LibTSP_Instance;
+
+// Version de l'API (LIBTSP_VERSION à la compilation de la bibliothèque)
+LIBTSP_API int libtsp_version(void);
+
+// Message lisible associé à un code de retour
+LIBTSP_API const char *libtsp_strerror(int code);
+
+// Lecture d'un fichier TSPLIB (NODE_COORD_SECTION) ; NULL si erreur
+LIBTSP_API LibTSP_Instance *libtsp_load(const char *filename);
+
+// Instance à partir de coordonnées en mémoire : ville i en (x[i * stride], y[i * stride]).
+// Un tableau (n, 2) contigu se passe avec x = base, y = base + 1, stride = 2 ; deux
+// tableaux séparés avec stride = 1. Les tampons ne sont lus que pendant l'appel.
+// dist_type : "EUC_2D" (défaut si NULL), "ATT" ou "GEO". NULL si erreur.
+LIBTSP_API LibTSP_Instance *libtsp_from_coords(int n, const double *x, const double *y, long stride,
+                                               const char *dist_type);
+
+LIBTSP_API void libtsp_free(LibTSP_Instance *inst);
+
+LIBTSP_API int libtsp_dimension(const LibTSP_Instance *inst);
+
+// Distance entre les villes i et j (selon EDGE_WEIGHT_TYPE) ; -1 si indice invalide
+LIBTSP_API double libtsp_distance(const LibTSP_Instance *inst, int i, int j);
+
+// 1 si la méthode existe (nn, nnms, nnms2opt, rw, nn2opt, rw2opt, bf, hk, bfenum, ga, gadpx, gaeax, gagpx,
+// sa, acs, acs2opt)
+LIBTSP_API int libtsp_is_method(const char *method);
+
+// Résout l'instance avec la méthode donnée.
+// params : "clé=valeur" séparés par des espaces, NULL ou "" pour les défauts
+//          (clés : pop gen mut mt=swap|inv|ins seed samples budget starts k threads stagnation).
+// tour   : tampon de n entiers rempli avec la tournée trouvée.
+// length : longueur de la tournée (peut être NULL).
+LIBTSP_API int libtsp_solve(const LibTSP_Instance *inst, const char *method, const char *params,
+                            int *tour, double *length);
+
+// Contrôle d'une résolution : échéance, annulation depuis un autre thread, progression.
+// progress (facultatif) reçoit chaque nouvelle meilleure longueur et le temps écoulé ; il peut
+// être appelé depuis les threads de calcul de la bibliothèque (jamais deux fois en même temps).
+typedef void (*LibTSP_Progress)(void *user, double best_length, double elapsed);
+typedef struct LibTSP_Control LibTSP_Control;
+
+// deadline_sec : durée maximale de chaque résolution (<= 0 : aucune)
+LIBTSP_API LibTSP_Control *libtsp_control_new(double deadline_sec, LibTSP_Progress progress, void *user);
+
+// Demande l'arrêt : la résolution en cours rend au plus vite sa meilleure tournée.
+// Définitif : les résolutions suivantes avec ce contrôle s'arrêtent aussitôt.
+LIBTSP_API void libtsp_control_cancel(LibTSP_Control *ctl);
+
+// Après une résolution : 1 si elle a été écourtée (annulation ou échéance), 0 sinon
+LIBTSP_API int libtsp_control_stopped(const LibTSP_Control *ctl);
+
+LIBTSP_API void libtsp_control_free(LibTSP_Control *ctl);
+
+// Comme libtsp_solve, sous le contrôle ctl (NULL : équivalent à libtsp_solve).
+// Un contrôle ne sert qu'à une résolution à la fois.
+LIBTSP_API int libtsp_solve_ctl(const LibTSP_Instance *inst, const char *method, const char *params,
+                                int *tour, double *length, LibTSP_Control *ctl);
+
+// Longueur d'une tournée de n villes (retour au départ compris) ; -1 si ce n'est pas une permutation
+LIBTSP_API double libtsp_tour_length(const LibTSP_Instance *inst, const int *tour, int n);
+
+// Ajoute une ligne au CSV de résumé (format de -o) ; entete = 1 écrase le fichier et écrit l'entête
+LIBTSP_API int libtsp_export_csv(const char *filename, const LibTSP_Instance *inst, const char *method,
+                                 double duration_sec, const int *tour, int entete);
+
+// Tournée seule, format selon l'extension : .tour (TSPLIB), .csv ou .bin (binaire compact)
+LIBTSP_API int libtsp_export_tour(const char *filename, const LibTSP_Instance *inst, const int *tour);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef LOWER_BOUND_H
+#define LOWER_BOUND_H
+
+#include "tsp_types.h"
+#include "solve_ctx.h"
+
+// Borne inférieure de Held-Karp : 1-arbres minimaux avec pénalités de nœuds
+// optimisées par sous-gradient. Le pas utilise la tournée du plus proche voisin comme
+// majorant : la borne ne dépend que de l'instance, pas de la méthode évaluée.
+// Coût plafonné (plus proche voisin compris) à LB_BUDGET_OPERATIONS accès à la matrice ;
+// ctx (NULL : aucun) arrête le calcul à l'échéance ou à l'annulation.
+// Retourne 0 (pas de borne) si aucune itération n'a pu être faite.
+double held_karp_bound(const TSP_Instance *inst, Solve_Context *ctx);
+
+// Écart relatif (length - lb) / lb, 0 si lb <= 0
+double optimality_gap(double length, double lb);
+
+#endif
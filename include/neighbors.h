@@ -0,0 +1,11 @@
+#ifndef NEIGHBORS_H
+#define NEIGHBORS_H
+
+#include "tsp_types.h"
+
+// Listes des k plus proches voisins de chaque ville, triées par distance croissante.
+// Tableau plat de taille n*k : les voisins de i sont dans [i*k .. i*k + k - 1].
+// k est borné à n-1 ; la valeur effective est renvoyée dans *k_out (si non NULL).
+int *build_neighbor_lists(const TSP_Instance *inst, int k, int *k_out);
+
+#endif
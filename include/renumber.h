@@ -0,0 +1,24 @@
+#ifndef RENUMBER_H
+#define RENUMBER_H
+
+#include "tsp_types.h"
+
+// Renumérotation des villes le long d'une courbe de Hilbert : des villes proches dans le
+// plan deviennent proches en indice, donc leurs lignes de inst->dist aussi en mémoire.
+// Les solveurs travaillent sur les nouveaux indices ; les tournées sont ramenées aux
+// identifiants d'origine avant l'affichage et l'export.
+
+// ordre[k] = ville placée en position k (grille 2^16 x 2^16 sur la boîte englobante) ;
+// NULL si l'allocation échoue
+int *hilbert_order(const double *x, const double *y, int n);
+
+// Réordonne les coordonnées de inst selon hilbert_order, avant le calcul de la matrice
+// (une matrice déjà calculée est recalculée). Retourne ordre (nouvel indice -> indice
+// d'origine, à libérer), NULL si erreur (inst inchangée)
+int *tsp_renumber_hilbert(TSP_Instance *inst);
+
+// Tournée fermée (n + 1 villes) en nouveaux indices -> identifiants d'origine, en place ;
+// la tournée est tournée pour commencer à la ville d'origine 0
+void tour_to_original(int *tour, int n, const int *ordre);
+
+#endif
@@ -0,0 +1,27 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+
+// Générateur splitmix64 : état de 64 bits propre à chaque flux (thread, réplique, fourmi).
+// Deux flux décorrélés : états initiaux graine + k * SPLITMIX64_GAMMA, puis un tirage.
+#define SPLITMIX64_GAMMA 0x9E3779B97F4A7C15ULL
+
+static inline uint64_t splitmix64(uint64_t *state) {
+    uint64_t x = (*state += SPLITMIX64_GAMMA);
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// Entier dans [0, borne) par multiplication (biais négligeable pour borne << 2^32)
+static inline int splitmix64_below(uint64_t *state, int borne) {
+    return (int)(((splitmix64(state) >> 32) * (uint64_t)borne) >> 32);
+}
+
+// Réel uniforme dans [0, 1) (53 bits)
+static inline double splitmix64_uniform(uint64_t *state) {
+    return (splitmix64(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include "solver.h"
+
+#define SERVE_CACHE_DEFAUT 8        // instances gardées en cache
+
+// Mode démon (--serve) : écoute sur une socket Unix et résout les requêtes sur
+// nb_workers threads. Protocole ligne à ligne, plusieurs requêtes par connexion :
+//   PING                                   -> PONG
+//   SOLVE method=<m> file=<fichier.tsp> [clé=valeur ...]
+//   SOLVE method=<m> n=<N> [type=EUC_2D|ATT|GEO] [clé=valeur ...]  suivie de N lignes "x y"
+//     clés : pop gen mut mt=swap|inv|ins seed samples budget (secondes, rw) starts k threads stagnation
+//            deadline (secondes : la meilleure tournée trouvée dans ce délai est rendue)
+//     -> OK length=<L> time=<s> n=<N> cache=hit|miss   puis la tournée (villes 1..N, retour inclus)
+//     -> ERR <message>
+//   QUIT                                   -> fermeture de la connexion
+// Les instances (matrice comprise) sont gardées dans un cache LRU de cache_capacity
+// entrées, indexé par une empreinte du contenu. S'arrête sur Ctrl-C ; retourne 0 si succès.
+int serve(const char *socket_path, const Solver_Params *defaults, int nb_workers, int cache_capacity);
+
+#endif
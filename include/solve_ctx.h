@@ -0,0 +1,46 @@
+#ifndef SOLVE_CTX_H
+#define SOLVE_CTX_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+
+// Contexte d'une résolution, transmis à chaque algorithme (NULL : seul Ctrl-C l'arrête).
+// Les boucles longues appellent solve_ctx_stop à intervalles bornés et rendent alors
+// la meilleure tournée déjà construite : une échéance donne une résolution « anytime ».
+
+// Progression : nouvelle meilleure longueur et temps écoulé depuis solve_ctx_init.
+// Peut être appelée depuis les threads de calcul (appels sérialisés par le contexte).
+typedef void (*Solve_Progress)(void *user, double best_length, double elapsed);
+
+typedef struct {
+    atomic_int cancelled;       // solve_ctx_cancel (depuis n'importe quel thread)
+    double start;               // wall_seconds() à l'initialisation
+    double deadline;            // instant limite (wall_seconds), 0 : aucun
+    Solve_Progress progress;    // facultatif
+    void *user;
+    pthread_mutex_t lock;       // sérialise progress et protège best
+    double best;                // meilleure longueur déjà signalée
+} Solve_Context;
+
+// budget : durée maximale en secondes à partir de maintenant (<= 0 : pas d'échéance)
+void solve_ctx_init(Solve_Context *ctx, double budget, Solve_Progress progress, void *user);
+void solve_ctx_destroy(Solve_Context *ctx);
+
+// Réarme un contexte pour une nouvelle résolution : échéance et meilleure longueur
+// repartent de maintenant, une annulation déjà demandée est conservée
+void solve_ctx_restart(Solve_Context *ctx, double budget);
+
+void solve_ctx_cancel(Solve_Context *ctx);
+
+// 1 si la résolution doit s'arrêter : annulation, échéance dépassée ou Ctrl-C
+int solve_ctx_stop(const Solve_Context *ctx);
+
+// Signale une tournée complète de longueur length (ignoré si elle n'améliore rien)
+void solve_ctx_report(Solve_Context *ctx, double length);
+
+// Vrai si un rappel de progression est installé (évite de calculer des longueurs pour rien)
+static inline int solve_ctx_wants_progress(const Solve_Context *ctx) {
+    return ctx && ctx->progress;
+}
+
+#endif
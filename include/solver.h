@@ -0,0 +1,45 @@
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include "tsp_types.h"
+#include "solve_ctx.h"
+#include "checkpoint.h"
+
+// Paramètres communs à toutes les méthodes (ceux qui ne concernent pas une méthode sont ignorés)
+typedef struct {
+    int pop_size;           // GA : taille de la population
+    int generations;        // GA : nombre de générations
+    double mut_rate;        // GA : taux de mutation
+    int mutation;           // GA : opérateur de mutation (GA_Mutation)
+    int nb_threads;         // threads internes (bfenum, nnms, rw, sa, acs)
+    int nn_departs;         // nnms : nombre de départs, 0 = tous
+    int nn_top_k;           // nnms2opt : tournées passées au 2-opt
+    long long rw_samples;   // rw : nombre de tirages (0 : voir rw_budget)
+    double rw_budget;       // rw, sa, acs : budget en secondes (0 : rw sans limite, sinon échéance ou défaut)
+    unsigned int seed;      // ga, rw, sa, acs : graine (0 : dérivée de l'horloge)
+    const char *ga_trace;   // ga : trace de convergence CSV (NULL : aucune)
+    int ga_stagnation;      // ga : arrêt après N générations sans amélioration (0 : jamais)
+    Checkpoint_Options checkpoint;  // ga, gadpx, gaeax, gagpx, bf, bfenum : sauvegarde et reprise
+} Solver_Params;
+
+// Méthodes exécutées par "-m all" et par la ligne "all" d'un fichier de jobs (--batch)
+#define SOLVER_ALL_NB 6
+extern const char *const solver_all_methodes[SOLVER_ALL_NB];
+
+void solver_default_params(Solver_Params *p);
+
+// 1 si la méthode existe (hors "all"), 0 sinon
+int solver_is_method(const char *methode);
+
+// 1 si la méthode attend les paramètres pop gen mut sur la ligne de commande
+int solver_needs_ga_params(const char *methode);
+
+// Applique un paramètre nommé (pop, gen, mut, mt, seed, samples, budget, starts, k, threads,
+// stagnation) ; retourne 1 si la clé est reconnue, 0 sinon (p inchangé)
+int solver_set_param(Solver_Params *p, const char *cle, const char *valeur);
+
+// Exécute une méthode ; retourne la tournée (n + 1 villes, tour[n] = tour[0]) ou NULL.
+// ctx (NULL : Ctrl-C seulement) : arrêt anticipé, la meilleure tournée trouvée est rendue.
+int *solver_run(const char *methode, const TSP_Instance *inst, const Solver_Params *p, Solve_Context *ctx);
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include <stdio.h>
+#include <stdatomic.h>
+
+// Instrumentation (--stats) : chronomètres par phase et compteurs des boucles chaudes.
+// Toujours compilée ; désactivée, chaque point de mesure se réduit à un test de stats_enabled.
+// Les boucles chaudes comptent dans des variables locales et publient une fois par appel.
+
+typedef enum {
+    STAT_PARSE,             // lecture du fichier TSPLIB
+    STAT_MATRIX,            // build_distance_matrix
+    STAT_CONSTRUCT,         // heuristiques de construction (nn, nnms, rw)
+    STAT_IMPROVE,           // passes 2-opt (imbriquées dans ga pour gadpx)
+    STAT_GA,                // boucle des générations du GA
+    STAT_BOUND,             // borne inférieure de Held-Karp
+    STAT_NB_PHASES
+} Stat_Phase;
+
+typedef enum {
+    STAT_DIST_LOOKUPS,      // accès à la matrice (nn, nnms, rw, 2-opt)
+    STAT_2OPT_EVALS,        // évaluations de gain 2-opt
+    STAT_2OPT_MOVES,        // mouvements 2-opt appliqués
+    STAT_GA_GENERATIONS,    // générations du GA
+    STAT_CROSSOVERS,        // croisements
+    STAT_CACHE_LOOKUPS,     // consultations du cache de tournées
+    STAT_CACHE_HITS,        // succès du cache de tournées
+    STAT_SA_MOVES,          // mouvements évalués par le recuit simulé
+    STAT_SA_ACCEPTED,       // mouvements acceptés par le recuit simulé
+    STAT_ACS_ANTS,          // fourmis construites (acs)
+    STAT_GPX_PARTITIONS,    // composantes échangées par le GPX
+    STAT_NB_COMPTEURS
+} Stat_Counter;
+
+extern int stats_enabled;
+extern _Atomic unsigned long long stats_counters[STAT_NB_COMPTEURS];
+
+static inline void stats_add(Stat_Counter c, unsigned long long v) {
+    if (stats_enabled)
+        atomic_fetch_add_explicit(&stats_counters[c], v, memory_order_relaxed);
+}
+
+// Début de phase : instant courant, 0 si l'instrumentation est désactivée
+double stats_begin(void);
+
+// Fin de phase : ajoute la durée écoulée depuis t0 (cumulée sur tous les threads)
+void stats_end(Stat_Phase p, double t0);
+
+// Résumé lisible (phases, compteurs, pic de mémoire résidente)
+void stats_print(FILE *out);
+
+// Même contenu au format JSON ; retourne 0 si succès, -1 si erreur d'ouverture
+int stats_export_json(const char *filename);
+
+#endif
@@ -0,0 +1,14 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+// Exécute task(ctx, i, worker) pour i = 0..nb_tasks-1 sur nb_threads threads
+// (<= 1 : séquentiel dans le thread appelant). Les tâches sont distribuées dans
+// l'ordre des indices ; worker (0..nb_threads-1) identifie le thread exécutant.
+// Retourne une fois toutes les tâches terminées.
+void pool_run(int nb_tasks, int nb_threads, void (*task)(void *ctx, int idx, int worker), void *ctx);
+
+// Horloges : temps réel monotone et temps CPU du thread appelant, en secondes
+double wall_seconds(void);
+double thread_cpu_seconds(void);
+
+#endif
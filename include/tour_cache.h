@@ -0,0 +1,31 @@
+#ifndef TOUR_CACHE_H
+#define TOUR_CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Empreinte canonique d'une tournée (permutation de 0..n-1, bouclée) :
+// somme des hachages de ses arêtes non orientées, donc indépendante de la
+// ville de départ et du sens de parcours.
+uint64_t tour_hash(const int *perm, int n);
+
+// Table de hachage bornée : empreinte -> tournée localement optimale + longueur
+typedef struct Tour_Cache Tour_Cache;
+
+// max_bytes borne la mémoire occupée par les tournées stockées
+Tour_Cache *tour_cache_create(int n, int min_slots, size_t max_bytes);
+void tour_cache_free(Tour_Cache *cache);
+
+// Retourne 1 et recopie la tournée et sa longueur si la clé est présente, 0 sinon
+int tour_cache_lookup(Tour_Cache *cache, uint64_t key, int *perm_out, double *length_out);
+void tour_cache_insert(Tour_Cache *cache, uint64_t key, const int *perm, double length);
+
+void tour_cache_stats(const Tour_Cache *cache, unsigned long long *lookups, unsigned long long *hits);
+
+// Contenu du cache pour une sauvegarde (entrées valides seulement) : taille en octets, copie
+// vers dst, puis restauration dans un cache créé avec les mêmes paramètres (0 si incompatible)
+size_t tour_cache_state_size(const Tour_Cache *cache);
+void tour_cache_state_get(const Tour_Cache *cache, void *dst);
+int tour_cache_state_set(Tour_Cache *cache, const void *src, size_t len);
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef TOUR_IO_H
+#define TOUR_IO_H
+
+#include <stddef.h>
+
+// Sérialisation des tournées : le texte est formaté dans un tampon (conversion des
+// entiers sans printf) puis émis en un seul write. Les villes sont écrites numérotées
+// à partir de 1 (convention TSPLIB), les tournées reçues sont en 0..n-1.
+
+typedef struct {
+    char *data;
+    size_t len;
+    size_t cap;
+    int erreur;             // allocation échouée : le contenu est incomplet
+} Tour_Buffer;
+
+void tour_buf_init(Tour_Buffer *b);
+void tour_buf_free(Tour_Buffer *b);
+void tour_buf_str(Tour_Buffer *b, const char *s);
+void tour_buf_bytes(Tour_Buffer *b, const void *data, size_t len);
+void tour_buf_int(Tour_Buffer *b, long long v);
+// Réel arrondi à decimales chiffres (formatage de snprintf : hors boucles chaudes)
+void tour_buf_double(Tour_Buffer *b, double v, int decimales);
+
+// Villes tour[0..n-1] (+1), séparées par sep ; close : répète la première à la fin
+void tour_buf_cities(Tour_Buffer *b, const int *tour, int n, char sep, int close);
+
+// Écrit tout le tampon sur fd (reprend les écritures partielles) ; 0 si succès, -1 sinon
+int tour_buf_write_fd(const Tour_Buffer *b, int fd);
+
+// Écrit le tampon dans filename (append : ajout en fin, sinon écrasement) ; 0 si succès, -1 sinon
+int tour_buf_write_file(const Tour_Buffer *b, const char *filename, int append);
+
+// Format déduit de l'extension
+typedef enum {
+    TOUR_FMT_CSV,           // .csv  : "position;ville", une ligne par ville, retour inclus
+    TOUR_FMT_TSPLIB,        // .tour : NAME / TYPE : TOUR / DIMENSION / TOUR_SECTION ... -1 / EOF
+    TOUR_FMT_BIN,           // .bin  : binaire compact (voir export_tour_bin)
+    TOUR_FMT_INCONNU
+} Tour_Format;
+
+Tour_Format tour_format_of(const char *filename);
+
+// TSPLIB TOUR_SECTION ; comment peut être NULL. 0 si succès, -1 sinon
+int export_tour_tsplib(const char *filename, const char *name, const char *comment, const int *tour, int n);
+
+// Binaire : "TSPT", version (uint32), n (uint32), puis n villes en int32 (0..n-1),
+// entiers petit-boutistes. 0 si succès, -1 sinon
+int export_tour_bin(const char *filename, const int *tour, int n);
+
+// Relit un fichier binaire ; retourne la tournée fermée (n + 1 villes) et n, NULL si invalide
+int *import_tour_bin(const char *filename, int *n);
+
+// Export selon l'extension de filename ; 0 si succès, -1 si erreur ou extension inconnue
+int export_tour(const char *filename, const char *name, const char *comment, const int *tour, int n);
+
+#endif
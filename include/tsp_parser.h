@@ -17,6 +17,13 @@ extern "C" {
 // - calcule la matrice des distances selon EDGE_WEIGHT_TYPE (EUC_2D, ATT, GEO)
 TSP_Instance *tsp_read_file(const char *filename);
 
+// Comme tsp_read_file, sans la matrice des distances (inst->dist = NULL) : permet de
+// réordonner les villes avant build_distance_matrix
+TSP_Instance *tsp_read_coords(const char *filename);
+
+// Construction à partir de coordonnées en mémoire (copiées) ; calcule aussi la matrice
+TSP_Instance *tsp_from_coords(const char *name, DistanceType type, int n, const double *x, const double *y);
+
 // Libération mémoire
 void tsp_free_instance(TSP_Instance *inst);
 
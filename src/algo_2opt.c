@@ -7,6 +7,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "algo_2opt.h"
+#include "stats.h"
 
 static inline double dist(const TSP_Instance *inst, int i, int j) {
     int n = inst->dimension;
@@ -29,17 +30,34 @@ static void reverse_segment(int *tour, int i, int j) {
 /**
  * Amélioration 2-opt :
  * On teste toutes les paires (i, j) et on applique l'inversion si le coût diminue.
+ * Retourne la somme des gains appliqués.
+ * Sur arrêt (ctx), le meilleur mouvement de la passe en cours est appliqué puis on sort.
+ * signaler : chaque nouvelle longueur est transmise à ctx (progression).
  */
-int improve_2opt(const TSP_Instance *inst, int *tour) {
+static double two_opt(const TSP_Instance *inst, int *tour, Solve_Context *ctx, int signaler) {
     int n = inst->dimension;
-    int improved = 0;
+    double total_gain = 0.0;
+    double t0 = stats_begin();
+    unsigned long long evals = 0, moves = 0;
+    int stop = 0;
+    double len0 = 0.0;
+    if (signaler && solve_ctx_wants_progress(ctx)) {
+        for (int i = 0; i < n; ++i)
+            len0 += dist(inst, tour[i], tour[(i + 1) % n]);
+    }
 
-    while (1) {
+    while (!stop) {
         double best_gain = 0.0;
         int best_i = -1, best_j = -1;
 
         for (int i = 0; i < n - 2; i++) {
+            // une ligne coûte O(n) : contrôle toutes les 16 lignes
+            if ((i & 15) == 0 && solve_ctx_stop(ctx)) {
+                stop = 1;
+                break;
+            }
             int A = tour[i];
+            evals += n - i - 2;
             int B = tour[i + 1];
 
             for (int j = i + 2; j < n; j++) {
@@ -61,11 +79,26 @@ int improve_2opt(const TSP_Instance *inst, int *tour) {
 
         if (best_gain > 0) {
             reverse_segment(tour, best_i + 1, best_j);
-            improved = 1;
+            total_gain += best_gain;
+            moves++;
+            if (len0 > 0.0)
+                solve_ctx_report(ctx, len0 - total_gain);
         } else {
             break; // stable
         }
     }
 
-    return improved;
+    stats_add(STAT_2OPT_EVALS, evals);
+    stats_add(STAT_2OPT_MOVES, moves);
+    stats_add(STAT_DIST_LOOKUPS, 4 * evals);
+    stats_end(STAT_IMPROVE, t0);
+    return total_gain;
+}
+
+double improve_2opt_gain(const TSP_Instance *inst, int *tour, Solve_Context *ctx) {
+    return two_opt(inst, tour, ctx, 0);
+}
+
+int improve_2opt(const TSP_Instance *inst, int *tour, Solve_Context *ctx) {
+    return two_opt(inst, tour, ctx, 1) > 0.0;
 }
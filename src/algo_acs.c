@@ -0,0 +1,232 @@
+/* algo_acs.c
+ * Ant Colony System pour le TSP.
+ * - phéromone tau et attractivité eta = (1 / d)^ACS_BETA sur les seules arêtes candidates
+ *   (k plus proches voisins), tableaux plats n * k ; une arête hors candidats vaut tau0 ;
+ * - transition : avec probabilité ACS_Q0, candidat libre maximisant tau * eta, sinon tirage
+ *   proportionnel à tau * eta parmi les candidats libres ; aucun candidat libre : ville
+ *   libre la plus proche (parcours de la liste des villes restantes) ;
+ * - mise à jour locale tau <- (1 - xi) tau + xi tau0 sur les arêtes parcourues, appliquée
+ *   après la construction de l'itération (les fourmis sont construites en parallèle sur
+ *   une phéromone figée, dans l'ordre des indices : résultat indépendant des threads) ;
+ * - mise à jour globale tau <- (1 - rho) tau + rho / L* sur la meilleure tournée connue.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "algo_acs.h"
+#include "algo_nn.h"
+#include "algo_2opt.h"
+#include "neighbors.h"
+#include "thread_pool.h"
+#include "stats.h"
+#include "rng.h"
+
+#define ACS_K       15      /* voisins candidats par ville */
+#define ACS_FOURMIS 10      /* fourmis par itération */
+#define ACS_BETA    2.0     /* poids de la distance */
+#define ACS_Q0      0.9     /* probabilité d'exploitation */
+#define ACS_RHO     0.1     /* évaporation globale */
+#define ACS_XI      0.1     /* évaporation locale */
+
+typedef struct {
+    const TSP_Instance *inst;
+    int n, k;
+    const int *cand;            /* n * k voisins */
+    const double *eta;          /* n * k : (1 / d)^beta */
+    double *tau;                /* n * k : phéromone */
+    double tau0;
+    uint64_t graine;
+    long long iteration;
+    int **fourmis;              /* ACS_FOURMIS tournées de n + 1 villes */
+    double *longueurs;
+    int **reste;                /* par worker : villes non visitées */
+    int **ou;                   /* par worker : position dans reste, -1 si visitée */
+} ACS;
+
+/* Indice de l'arête (i, j) dans la liste de i, -1 si j n'est pas candidat de i */
+static inline int arete(const ACS *a, int i, int j) {
+    const int *c = a->cand + (size_t)i * a->k;
+    for (int s = 0; s < a->k; ++s)
+        if (c[s] == j) return s;
+    return -1;
+}
+
+/* tau <- (1 - evap) tau + evap * depot dans les deux listes concernées */
+static inline void deposer(ACS *a, int i, int j, double evap, double depot) {
+    int s = arete(a, i, j);
+    if (s >= 0) {
+        double *t = &a->tau[(size_t)i * a->k + s];
+        *t = (1.0 - evap) * *t + evap * depot;
+    }
+    s = arete(a, j, i);
+    if (s >= 0) {
+        double *t = &a->tau[(size_t)j * a->k + s];
+        *t = (1.0 - evap) * *t + evap * depot;
+    }
+}
+
+static void construire(void *ctx, int f, int worker) {
+    ACS *a = ctx;
+    int n = a->n, k = a->k;
+    int *tour = a->fourmis[f];
+    int *reste = a->reste[worker], *ou = a->ou[worker];
+    const double *d = a->inst->dist;
+    // un flux splitmix64 par fourmi (itération, indice) : indépendant du thread
+    uint64_t rng = a->graine + (uint64_t)(a->iteration * ACS_FOURMIS + f) * SPLITMIX64_GAMMA;
+    splitmix64(&rng);
+
+    for (int v = 0; v < n; ++v) {
+        reste[v] = v;
+        ou[v] = v;
+    }
+    int libres = n;
+    int cur = splitmix64_below(&rng, n);
+    double len = 0.0;
+
+    for (int pos = 0; ; ++pos) {
+        // retrait de cur des villes restantes (échange avec la dernière)
+        int last = reste[--libres];
+        reste[ou[cur]] = last;
+        ou[last] = ou[cur];
+        ou[cur] = -1;
+        tour[pos] = cur;
+        if (libres == 0) break;
+
+        const int *c = a->cand + (size_t)cur * k;
+        const double *tau = a->tau + (size_t)cur * k;
+        const double *eta = a->eta + (size_t)cur * k;
+        int next = -1;
+        if (splitmix64_uniform(&rng) < ACS_Q0) {
+            double best = -1.0;
+            for (int s = 0; s < k; ++s)
+                if (ou[c[s]] >= 0 && tau[s] * eta[s] > best) {
+                    best = tau[s] * eta[s];
+                    next = c[s];
+                }
+        } else {
+            double somme = 0.0;
+            for (int s = 0; s < k; ++s)
+                if (ou[c[s]] >= 0) somme += tau[s] * eta[s];
+            if (somme > 0.0) {
+                double u = splitmix64_uniform(&rng) * somme;
+                for (int s = 0; s < k; ++s)
+                    if (ou[c[s]] >= 0) {
+                        next = c[s];
+                        u -= tau[s] * eta[s];
+                        if (u <= 0.0) break;
+                    }
+            }
+        }
+        if (next < 0) {
+            // candidats épuisés : la ville libre la plus proche (tau0 partout ailleurs)
+            const double *row = d + (size_t)cur * n;
+            next = reste[0];
+            for (int r = 1; r < libres; ++r)
+                if (row[reste[r]] < row[next]) next = reste[r];
+        }
+        len += d[(size_t)cur * n + next];
+        cur = next;
+    }
+    tour[n] = tour[0];
+    a->longueurs[f] = len + d[(size_t)tour[n - 1] * n + tour[0]];
+}
+
+int* acs_tour(const TSP_Instance *inst, double time_budget, int nb_threads, int with_2opt,
+              unsigned long long seed, Solve_Context *ctx) {
+    int n = inst->dimension;
+    if (n <= 0 || !inst->dist) return NULL;
+
+    int *best = nn_tour(inst, ctx);
+    if (!best || n < 4) return best;
+
+    if (time_budget <= 0)
+        time_budget = (ctx && ctx->deadline > 0) ? ctx->deadline - wall_seconds() : ACS_BUDGET_DEFAUT;
+    if (nb_threads < 1) nb_threads = 1;
+    if (nb_threads > ACS_FOURMIS) nb_threads = ACS_FOURMIS;
+
+    ACS a;
+    memset(&a, 0, sizeof(a));
+    a.inst = inst;
+    a.n = n;
+    int *cand = build_neighbor_lists(inst, ACS_K, &a.k);
+    double *eta = cand ? malloc((size_t)n * a.k * sizeof(double)) : NULL;
+    double *tau = cand ? malloc((size_t)n * a.k * sizeof(double)) : NULL;
+    a.fourmis = calloc(ACS_FOURMIS, sizeof(int *));
+    a.longueurs = malloc(ACS_FOURMIS * sizeof(double));
+    a.reste = calloc(nb_threads, sizeof(int *));
+    a.ou = calloc(nb_threads, sizeof(int *));
+    int ok = (eta && tau && a.fourmis && a.longueurs && a.reste && a.ou);
+    for (int f = 0; ok && f < ACS_FOURMIS; ++f)
+        ok = (a.fourmis[f] = malloc((n + 1) * sizeof(int))) != NULL;
+    for (int t = 0; ok && t < nb_threads; ++t) {
+        a.reste[t] = malloc(n * sizeof(int));
+        a.ou[t] = malloc(n * sizeof(int));
+        ok = (a.reste[t] && a.ou[t]);
+    }
+
+    if (ok) {
+        double best_len = tour_length(inst, best);
+        a.cand = cand;
+        a.eta = eta;
+        a.tau = tau;
+        a.tau0 = 1.0 / (n * best_len);
+        a.graine = seed ? seed : (uint64_t)time(NULL);
+        for (size_t e = 0; e < (size_t)n * a.k; ++e) {
+            int i = (int)(e / a.k);
+            double dij = inst->dist[(size_t)i * n + cand[e]];
+            eta[e] = pow(1.0 / (dij > 0 ? dij : 1e-9), ACS_BETA);
+            tau[e] = a.tau0;
+        }
+
+        double t0 = wall_seconds();
+        unsigned long long fourmis = 0;
+        for (a.iteration = 0; ; a.iteration++) {
+            double t_c = stats_begin();
+            pool_run(ACS_FOURMIS, nb_threads, construire, &a);
+            stats_end(STAT_CONSTRUCT, t_c);
+            fourmis += ACS_FOURMIS;
+
+            int it = 0;
+            for (int f = 0; f < ACS_FOURMIS; ++f) {
+                const int *t = a.fourmis[f];
+                for (int i = 0; i < n; ++i)
+                    deposer(&a, t[i], t[i + 1], ACS_XI, a.tau0);
+                if (a.longueurs[f] < a.longueurs[it]) it = f;
+            }
+            if (with_2opt)
+                a.longueurs[it] -= improve_2opt_gain(inst, a.fourmis[it], ctx);
+            if (a.longueurs[it] < best_len - 1e-9) {
+                best_len = a.longueurs[it];
+                memcpy(best, a.fourmis[it], (n + 1) * sizeof(int));
+                solve_ctx_report(ctx, best_len);
+            }
+
+            for (int i = 0; i < n; ++i)
+                deposer(&a, best[i], best[i + 1], ACS_RHO, 1.0 / best_len);
+
+            if (wall_seconds() - t0 >= time_budget || solve_ctx_stop(ctx)) break;
+        }
+        stats_add(STAT_ACS_ANTS, fourmis);
+        if (stats_enabled)
+            fprintf(stderr, "[ACS] %lld itérations, %llu fourmis\n", a.iteration + 1, fourmis);
+    }
+
+    for (int f = 0; a.fourmis && f < ACS_FOURMIS; ++f)
+        free(a.fourmis[f]);
+    for (int t = 0; a.reste && t < nb_threads; ++t) {
+        free(a.reste[t]);
+        free(a.ou[t]);
+    }
+    free(a.fourmis);
+    free(a.longueurs);
+    free(a.reste);
+    free(a.ou);
+    free(eta);
+    free(tau);
+    free(cand);
+    return best;
+}
@@ -0,0 +1,274 @@
+/* algo_bb.c
+ * Solveur exact du TSP par séparation et évaluation (branch-and-bound).
+ * - la ville 0 est fixée en tête, et l'on impose tour[1] < tour[n-1]
+ *   pour ne pas explorer chaque tournée dans les deux sens ;
+ * - coût du préfixe mis à jour incrémentalement ;
+ * - solution initiale NN + 2-opt ;
+ * - borne inférieure : chaque ville restante a deux arêtes incidentes vers les
+ *   villes restantes ou les extrémités du chemin (demi-somme des deux plus petites).
+ * Respecte le contexte de résolution (annulation, échéance, Ctrl-C) : on renvoie
+ * alors la meilleure tournée connue.
+ * Sauvegarde : le parcours étant déterministe (voisins triés), le préfixe courant
+ * suffit à décrire tout ce qui a déjà été exploré.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "algo_bb.h"
+#include "algo_nn.h"
+#include "algo_2opt.h"
+#include "neighbors.h"
+#include "thread_pool.h"
+#include "tour_io.h"
+
+#define BB_CK_TYPE "BB01"
+
+typedef struct {
+    const TSP_Instance *inst;
+    Solve_Context *ctx;
+    int stop;             /* arrêt constaté : toute la récursion remonte */
+    unsigned noeuds;      /* nœuds visités depuis le dernier contrôle */
+    int n;
+    const int *order;     /* n*(n-1) : voisins de chaque ville triés par distance */
+    int *path;            /* préfixe courant, path[0] = 0 */
+    char *visited;
+    int *unvisited;       /* tampon pour la borne */
+    int *best;            /* meilleure tournée (n villes) */
+    double best_len;
+    const Checkpoint_Options *cp;
+    uint64_t signature;
+    double periode;       /* secondes entre deux sauvegardes */
+    double prochaine_sauvegarde;
+    int arret_profondeur; /* préfixe path[0..arret_profondeur) pas encore exploré à l'arrêt */
+    const int *reprise;   /* reprise : préfixe à rejoindre avant d'explorer (NULL ensuite) */
+    int reprise_len;
+} BB_State;
+
+static inline double D(const BB_State *st, int i, int j) {
+    return st->inst->dist[(size_t)i * st->n + j];
+}
+
+/* Borne inférieure du chemin restant cur -> (villes non visitées) -> 0.
+ * *sym_ok passe à 0 si toutes les villes restantes ont un indice < path[1] :
+ * la dernière ville violerait alors la règle de symétrie. */
+static double remaining_bound(BB_State *st, int cur, int depth, int *sym_ok) {
+    int n = st->n;
+    int k = 0;
+    int first = (depth > 1) ? st->path[1] : -1;
+    int any_above = (first < 0);
+
+    for (int v = 0; v < n; ++v)
+        if (!st->visited[v]) {
+            st->unvisited[k++] = v;
+            if (v > first) any_above = 1;
+        }
+    *sym_ok = any_above;
+
+    double sum = 0.0;
+    double m_cur = 1e300, m_0 = 1e300;
+
+    for (int a = 0; a < k; ++a) {
+        int v = st->unvisited[a];
+        double d_cur = D(st, v, cur);
+        double d_0 = D(st, v, 0);
+        double a1 = d_cur, a2 = d_0;
+        if (a2 < a1) { a1 = d_0; a2 = d_cur; }
+
+        for (int b = 0; b < k; ++b) {
+            if (b == a) continue;
+            double d = D(st, v, st->unvisited[b]);
+            if (d < a1) { a2 = a1; a1 = d; }
+            else if (d < a2) a2 = d;
+        }
+        sum += a1 + a2;
+        if (d_cur < m_cur) m_cur = d_cur;
+        if (d_0 < m_0) m_0 = d_0;
+    }
+
+    return 0.5 * (sum + m_cur + m_0);
+}
+
+/* Sauvegarde : signature, n, terminé, meilleure longueur et tournée, puis le préfixe
+ * path[0..depth) dont le sous-arbre reste à explorer (tout ce qui le précède l'a été) */
+static void bb_checkpoint_save(const BB_State *st, int depth, int termine) {
+    Tour_Buffer b;
+    tour_buf_init(&b);
+    tour_buf_bytes(&b, &st->signature, sizeof(st->signature));
+    tour_buf_bytes(&b, &st->n, sizeof(int));
+    tour_buf_bytes(&b, &termine, sizeof(int));
+    tour_buf_bytes(&b, &st->best_len, sizeof(double));
+    tour_buf_bytes(&b, st->best, st->n * sizeof(int));
+    tour_buf_bytes(&b, &depth, sizeof(int));
+    tour_buf_bytes(&b, st->path, depth * sizeof(int));
+    if (!b.erreur)
+        checkpoint_write(st->cp->file, BB_CK_TYPE, b.data, b.len);
+    tour_buf_free(&b);
+}
+
+/* Relit une sauvegarde de la même instance dans st (meilleure tournée) et *chemin
+ * (préfixe à rejoindre, à libérer). Retourne -1 si absente ou invalide, sinon terminé (0/1). */
+static int bb_checkpoint_load(BB_State *st, int **chemin, int *chemin_len) {
+    size_t len;
+    void *data = checkpoint_read(st->cp->file, BB_CK_TYPE, &len);
+    if (!data) return -1;
+
+    int n = st->n, m = 0, termine = 0;
+    uint64_t signature;
+    Checkpoint_Reader r = { data, len };
+    int ok = checkpoint_get(&r, &signature, sizeof(signature)) && signature == st->signature &&
+             checkpoint_get(&r, &m, sizeof(int)) && m == n &&
+             checkpoint_get(&r, &termine, sizeof(int)) &&
+             checkpoint_get(&r, &st->best_len, sizeof(double)) &&
+             checkpoint_get(&r, st->best, n * sizeof(int)) &&
+             checkpoint_get(&r, &m, sizeof(int)) && m >= 1 && m <= n && r.reste == (size_t)m * sizeof(int);
+    int *p = ok ? malloc(m * sizeof(int)) : NULL;
+    ok = p && checkpoint_get(&r, p, m * sizeof(int)) && p[0] == 0;
+    free(data);
+    if (!ok) {
+        free(p);
+        fprintf(stderr, "[BB] %s : sauvegarde d'une autre instance, ignorée\n", st->cp->file);
+        return -1;
+    }
+    *chemin = p;
+    *chemin_len = m;
+    return termine;
+}
+
+static void bb_search(BB_State *st, int depth, int cur, double cost) {
+    // chaque nœud coûte au moins O(n) (borne) : contrôle tous les 256 nœuds
+    if ((++st->noeuds & 255) == 0) {
+        if (solve_ctx_stop(st->ctx)) {
+            st->stop = 1;
+            st->arret_profondeur = depth;
+        } else if (st->cp && wall_seconds() >= st->prochaine_sauvegarde) {
+            bb_checkpoint_save(st, depth, 0);
+            st->prochaine_sauvegarde = wall_seconds() + st->periode;
+        }
+    }
+    if (st->stop)
+        return;
+
+    int n = st->n;
+
+    if (depth == n) {
+        if (st->path[1] > st->path[n - 1])
+            return;
+        double total = cost + D(st, cur, 0);
+        if (total < st->best_len) {
+            st->best_len = total;
+            memcpy(st->best, st->path, n * sizeof(int));
+            solve_ctx_report(st->ctx, total);
+        }
+        return;
+    }
+
+    int sym_ok;
+    if (cost + remaining_bound(st, cur, depth, &sym_ok) >= st->best_len || !sym_ok)
+        return;
+
+    // Voisins du plus proche au plus lointain : dès que le préfixe dépasse la
+    // meilleure solution, les suivants aussi.
+    const int *nb = st->order + (size_t)cur * (n - 1);
+    for (int r = 0; r < n - 1; ++r) {
+        int v = nb[r];
+        if (st->visited[v]) continue;
+
+        // Reprise : les voisins qui précèdent le préfixe sauvegardé sont déjà explorés
+        if (st->reprise) {
+            if (v != st->reprise[depth]) continue;
+            if (depth + 1 >= st->reprise_len) st->reprise = NULL;
+        }
+
+        double c = cost + D(st, cur, v);
+        if (c >= st->best_len) {
+            st->reprise = NULL;
+            break;
+        }
+
+        st->visited[v] = 1;
+        st->path[depth] = v;
+        bb_search(st, depth + 1, v, c);
+        st->visited[v] = 0;
+        st->reprise = NULL;
+
+        if (st->stop)
+            return;
+    }
+}
+
+int* bb_tour(const TSP_Instance *inst, Solve_Context *ctx, const Checkpoint_Options *cp) {
+    int n = inst->dimension;
+    if (n <= 0 || !inst->dist) return NULL;
+
+    // Solution initiale NN + 2-opt (optimale pour n <= 3)
+    int *tour = nn_tour(inst, ctx);
+    if (!tour) return NULL;
+    if (n <= 3) return tour;
+
+    BB_State st;
+    st.cp = (cp && cp->file) ? cp : NULL;
+    st.signature = st.cp ? checkpoint_signature(inst) : 0;
+    st.reprise = NULL;
+    st.reprise_len = 0;
+    st.arret_profondeur = 1;
+    st.periode = (st.cp && st.cp->periode > 0) ? st.cp->periode : CHECKPOINT_PERIODE_DEFAUT;
+    st.prochaine_sauvegarde = wall_seconds() + st.periode;
+    st.inst = inst;
+    st.ctx = ctx;
+    st.stop = 0;
+    st.noeuds = 0;
+    st.n = n;
+    st.order = build_neighbor_lists(inst, n - 1, NULL);
+    st.path = malloc(n * sizeof(int));
+    st.visited = calloc(n, 1);
+    st.unvisited = malloc(n * sizeof(int));
+    st.best = malloc(n * sizeof(int));
+
+    if (!st.order || !st.path || !st.visited || !st.unvisited || !st.best) {
+        free((int *)st.order);
+        free(st.path);
+        free(st.visited);
+        free(st.unvisited);
+        free(st.best);
+        return tour;
+    }
+
+    // Reprise : incumbent et préfixe sauvegardés (le NN + 2-opt initial est inutile)
+    int *chemin = NULL;
+    int termine = st.cp && st.cp->reprise ? bb_checkpoint_load(&st, &chemin, &st.reprise_len) : -1;
+    if (termine >= 0) {
+        fprintf(stderr, "[BB] reprise de %s (%s, meilleure longueur %.0f)\n", st.cp->file,
+                termine ? "recherche terminée" : "préfixe sauvegardé", st.best_len);
+        // reprise[k] : ville attendue à la profondeur k (reprise[0] = 0 est déjà placée)
+        if (!termine && st.reprise_len > 1) st.reprise = chemin;
+    } else {
+        // Incumbent : la tournée 2-opt, tournée pour commencer en 0
+        improve_2opt(inst, tour, ctx);
+        int start = 0;
+        while (tour[start] != 0) start++;
+        for (int i = 0; i < n; ++i)
+            st.best[i] = tour[(start + i) % n];
+        st.best_len = tour_length(inst, tour);
+    }
+    solve_ctx_report(ctx, st.best_len);
+
+    st.path[0] = 0;
+    st.visited[0] = 1;
+    if (termine != 1) {
+        bb_search(&st, 1, 0, 0.0);
+        if (st.cp) bb_checkpoint_save(&st, st.stop ? st.arret_profondeur : 1, !st.stop);
+    }
+    free(chemin);
+
+    for (int i = 0; i < n; ++i)
+        tour[i] = st.best[i];
+    tour[n] = tour[0];
+
+    free((int *)st.order);
+    free(st.path);
+    free(st.visited);
+    free(st.unvisited);
+    free(st.best);
+    return tour;
+}
@@ -2,72 +2,606 @@
  * Implémente la recherche exhaustive (génération lexicographique des permutations).
  * Met à jour la meilleure tournée trouvée ; doit respecter le handler Ctrl-C.
  * Entrée : Instance + dist_fct ; Sortie : meilleure Tour et sa longueur.
+ *
+ * Moteur unique piloté par les hooks de brute_incr() : coût du préfixe tenu
+ * incrémentalement, élagage par le coût du préfixe et par le minorant facultatif.
+ * brute() (coût calculé sur la permutation complète) passe par un adaptateur.
+ *
+ * Version parallèle (nb_ressources > 1) : l'arbre des permutations est découpé
+ * en tâches (préfixes de longueur fixe) réparties sur des deques de vol de travail.
+ * Chaque worker dépile ses tâches par le bas, vole les autres par le haut, et
+ * redécoupe une tâche en sous-préfixes quand des workers sont inactifs.
+ * Le meilleur coût est partagé par compare-and-swap atomique. En cas d'égalité,
+ * la permutation lexicographiquement la plus petite est retenue, comme en séquentiel.
+ *
+ * Sauvegarde (brute_incr_cp) : toujours en tâches, même avec un seul worker. Chaque tâche
+ * garde l'indice de sa racine ; une racine est terminée quand toutes les tâches qui en
+ * descendent l'ont été sans interruption. La meilleure permutation est alors aussi tenue
+ * sous verrou pour être sauvegardée.
  */
 
 #include <stdlib.h>
 #include <stdbool.h>
 #include <string.h>
 #include <signal.h>
+#include <sched.h>
+#include <pthread.h>
+#include <stdatomic.h>
 #include "algo_bf.h"
+#include "thread_pool.h"
+
+#define BF_MAX_PREFIX        12   /* profondeur maximale de découpage d'une tâche */
+#define BF_TACHES_PAR_THREAD 16   /* tâches initiales visées par worker */
+#define BF_RACINES_SAUVEGARDE 1024 /* tâches racines visées avec sauvegarde */
+#define BF_PERIODE_SAUVEGARDE 60.0
 
 // variable globale définie dans main.c
 extern volatile sig_atomic_t stop_requested;
 
-static void permute(int nb_nodes, int pos, int *perm, bool *used,
-                    int *best_perm, unsigned long long *count_best,
-                    void *(*cout)(void *, int *)) {
+/* ---------------------------------------------------------------------
+ *  Moteur de recherche (séquentiel = un seul worker, sans thread)
+ * --------------------------------------------------------------------- */
 
-    // Si Ctrl-C → on arrête immédiatement la récursion
-    if (stop_requested)
-        return;
+typedef struct {
+    int len;
+    int racine;                 /* indice de la tâche initiale dont elle descend */
+    int prefix[BF_MAX_PREFIX];
+} BF_Task;
+
+/* Deque protégée par un verrou : le propriétaire travaille en bas (LIFO),
+ * les voleurs prennent en haut (les tâches les plus grosses). */
+typedef struct {
+    pthread_mutex_t lock;
+    BF_Task *tasks;
+    int head, tail, cap;        /* tâches dans [head, tail) */
+} BF_Deque;
+
+typedef struct {
+    int nb_nodes;
+    int nb_workers;
+    int split_depth;
+    BF_Deque *deques;
+    atomic_int pending;         /* tâches créées et non terminées */
+    atomic_int idle;            /* workers sans travail */
+    _Atomic unsigned long long best_cost;
+    atomic_int arret;           /* hook stop déclenché : tous les workers s'arrêtent */
+    const BF_Hooks *hooks;
+    void *ctx;
+
+    /* sauvegarde (cp non NULL) */
+    BF_Checkpoint *cp;
+    int nb_racines;
+    int racine_len;             /* longueur des préfixes racines */
+    int racine_suivante;        /* numérotation des tâches initiales */
+    atomic_int *restant;        /* tâches non terminées de chaque racine (0 : racine terminée) */
+    pthread_mutex_t cp_lock;    /* meilleure permutation partagée et sauvegardes */
+    unsigned long long cp_best_cost;
+    int *cp_best_perm;
+    double periode;
+    double prochaine_sauvegarde;
+} BF_Shared;
+
+typedef struct {
+    BF_Shared *sh;
+    int id;
+    pthread_t thread;
+    int *perm;
+    bool *used;
+    unsigned long long *prefix_cost;  /* prefix_cost[p] = coût de perm[0..p-1] */
+    int *best_perm;
+    unsigned long long best_cost;
+    unsigned noeuds;            /* nœuds visités depuis le dernier appel au hook stop */
+} BF_Worker;
+
+static int deque_push(BF_Deque *dq, const BF_Task *t) {
+    pthread_mutex_lock(&dq->lock);
+    if (dq->tail == dq->cap) {
+        if (dq->head > 0) {
+            memmove(dq->tasks, dq->tasks + dq->head, (dq->tail - dq->head) * sizeof(BF_Task));
+            dq->tail -= dq->head;
+            dq->head = 0;
+        } else {
+            int cap = dq->cap ? 2 * dq->cap : 64;
+            BF_Task *tasks = realloc(dq->tasks, cap * sizeof(BF_Task));
+            if (!tasks) {
+                pthread_mutex_unlock(&dq->lock);
+                return 0;
+            }
+            dq->tasks = tasks;
+            dq->cap = cap;
+        }
+    }
+    dq->tasks[dq->tail++] = *t;
+    pthread_mutex_unlock(&dq->lock);
+    return 1;
+}
+
+static int deque_pop(BF_Deque *dq, BF_Task *t) {
+    int ok = 0;
+    pthread_mutex_lock(&dq->lock);
+    if (dq->tail > dq->head) {
+        *t = dq->tasks[--dq->tail];
+        ok = 1;
+    }
+    pthread_mutex_unlock(&dq->lock);
+    return ok;
+}
+
+static int deque_steal(BF_Deque *dq, BF_Task *t) {
+    int ok = 0;
+    pthread_mutex_lock(&dq->lock);
+    if (dq->tail > dq->head) {
+        *t = dq->tasks[dq->head++];
+        ok = 1;
+    }
+    pthread_mutex_unlock(&dq->lock);
+    return ok;
+}
+
+static void publish_best(BF_Shared *sh, unsigned long long cost) {
+    unsigned long long cur = atomic_load(&sh->best_cost);
+    while (cost < cur && !atomic_compare_exchange_weak(&sh->best_cost, &cur, cost))
+        ;
+}
 
-    if (pos == nb_nodes) {
-        void *res = cout(NULL, perm);
-        if (res != NULL) {
-            unsigned long long cost = *(unsigned long long *)res;
-            if (cost < *count_best) {
-                *count_best = cost;
-                memcpy(best_perm, perm, nb_nodes * sizeof(int));
+/* 1 si (cost, perm) précède (best_cost, best_perm) : coût puis ordre lexicographique */
+static int precedes(unsigned long long cost, const int *perm,
+                    unsigned long long best_cost, const int *best_perm, int n) {
+    if (cost != best_cost || best_cost == ~0ULL)
+        return cost < best_cost;
+    for (int i = 0; i < n; ++i)
+        if (perm[i] != best_perm[i])
+            return perm[i] < best_perm[i];
+    return 0;
+}
+
+static void leaf(BF_Worker *w, unsigned long long cost) {
+    BF_Shared *sh = w->sh;
+    int n = sh->nb_nodes;
+
+    if (sh->hooks->close) {
+        unsigned long long c = sh->hooks->close(sh->ctx, w->perm, n);
+        if (c == BF_INFEASIBLE)
+            return;
+        cost += c;
+    }
+
+    if (precedes(cost, w->perm, w->best_cost, w->best_perm, n)) {
+        w->best_cost = cost;
+        memcpy(w->best_perm, w->perm, n * sizeof(int));
+        publish_best(sh, cost);
+        if (sh->cp) {
+            pthread_mutex_lock(&sh->cp_lock);
+            if (precedes(cost, w->perm, sh->cp_best_cost, sh->cp_best_perm, n)) {
+                sh->cp_best_cost = cost;
+                memcpy(sh->cp_best_perm, w->perm, n * sizeof(int));
             }
-            free(res);
+            pthread_mutex_unlock(&sh->cp_lock);
         }
+    }
+}
+
+/* Place perm[pos] = e ; retourne 0 si la branche est coupée (rien à défaire) */
+static int push_element(BF_Worker *w, int pos, int e) {
+    BF_Shared *sh = w->sh;
+    const BF_Hooks *h = sh->hooks;
+
+    w->perm[pos] = e;
+    unsigned long long c = h->extend ? h->extend(sh->ctx, w->perm, pos) : 0;
+    if (c == BF_INFEASIBLE)
+        return 0;
+
+    // Coûts positifs : le préfixe seul suffit à élaguer. L'égalité est conservée
+    // pour retrouver la même permutation (ordre lexicographique) quel que soit
+    // le nombre de threads.
+    unsigned long long best = atomic_load_explicit(&sh->best_cost, memory_order_relaxed);
+    c += w->prefix_cost[pos];
+    if (c > best) {
+        if (h->retract) h->retract(sh->ctx, w->perm, pos);
+        return 0;
+    }
+
+    w->used[e] = true;
+    if (h->lower_bound && pos + 1 < sh->nb_nodes) {
+        unsigned long long lb = h->lower_bound(sh->ctx, w->perm, pos, w->used);
+        if (lb == BF_INFEASIBLE || c + lb > best) {
+            w->used[e] = false;
+            if (h->retract) h->retract(sh->ctx, w->perm, pos);
+            return 0;
+        }
+    }
+
+    w->prefix_cost[pos + 1] = c;
+    return 1;
+}
+
+static void pop_element(BF_Worker *w, int pos) {
+    BF_Shared *sh = w->sh;
+    w->used[w->perm[pos]] = false;
+    if (sh->hooks->retract)
+        sh->hooks->retract(sh->ctx, w->perm, pos);
+}
+
+static void search(BF_Worker *w, int pos) {
+    BF_Shared *sh = w->sh;
+    int n = sh->nb_nodes;
+
+    if (sh->hooks->stop && ++w->noeuds == BF_PERIODE_ARRET) {
+        w->noeuds = 0;
+        if (sh->hooks->stop(sh->ctx))
+            atomic_store(&sh->arret, 1);
+    }
+    // Si Ctrl-C ou arrêt demandé → on arrête immédiatement la récursion
+    if (stop_requested || atomic_load_explicit(&sh->arret, memory_order_relaxed))
+        return;
+
+    if (pos == n) {
+        leaf(w, w->prefix_cost[n]);
         return;
     }
 
-    for (int i = 0; i < nb_nodes; ++i) {
-        if (stop_requested)
+    for (int i = 0; i < n; ++i) {
+        if (w->used[i]) continue;
+        if (!push_element(w, pos, i)) continue;
+        search(w, pos + 1);
+        pop_element(w, pos);
+        if (stop_requested || atomic_load_explicit(&sh->arret, memory_order_relaxed))
             return;
+    }
+}
+
+static void run_task(BF_Worker *w, const BF_Task *t) {
+    BF_Shared *sh = w->sh;
+    int n = sh->nb_nodes;
+
+    // Rejoue le préfixe de la tâche ; une tâche infaisable se termine aussitôt
+    int depth = 0;
+    while (depth < t->len && push_element(w, depth, t->prefix[depth]))
+        depth++;
+
+    if (depth == t->len) {
+        if (t->len < sh->split_depth && atomic_load(&sh->idle) > 0) {
+            // Des workers attendent : on redécoupe la tâche en sous-préfixes
+            BF_Task child = *t;
+            child.len = t->len + 1;
+            for (int i = n - 1; i >= 0; --i) {   /* ordre inverse : le plus petit est dépilé en premier */
+                if (w->used[i]) continue;
+                child.prefix[t->len] = i;
+                atomic_fetch_add(&sh->pending, 1);
+                if (sh->restant) atomic_fetch_add(&sh->restant[t->racine], 1);
+                if (!deque_push(&sh->deques[w->id], &child)) {
+                    atomic_fetch_sub(&sh->pending, 1);
+                    if (sh->restant) atomic_fetch_sub(&sh->restant[t->racine], 1);
+                    if (push_element(w, t->len, i)) {
+                        search(w, t->len + 1);
+                        pop_element(w, t->len);
+                    }
+                }
+            }
+        } else {
+            search(w, t->len);
+        }
+    }
+
+    while (depth > 0)
+        pop_element(w, --depth);
+}
+
+/* État : BF_Etat, puis nb_racines octets (1 : racine terminée) et la meilleure permutation */
+typedef struct {
+    int nb_nodes, prefix_len, nb_racines;
+    unsigned long long best_cost;
+} BF_Etat;
+
+/* Appelée sous cp_lock */
+static void checkpoint_save(BF_Shared *sh) {
+    size_t taille = sizeof(BF_Etat) + sh->nb_racines + sh->nb_nodes * sizeof(int);
+    unsigned char *etat = malloc(taille);
+    if (!etat) return;
+    BF_Etat e;
+    memset(&e, 0, sizeof(e));
+    e.nb_nodes = sh->nb_nodes;
+    e.prefix_len = sh->racine_len;
+    e.nb_racines = sh->nb_racines;
+    e.best_cost = sh->cp_best_cost;
+    memcpy(etat, &e, sizeof(e));
+    for (int r = 0; r < sh->nb_racines; ++r)
+        etat[sizeof(e) + r] = (atomic_load(&sh->restant[r]) == 0);
+    memcpy(etat + sizeof(e) + sh->nb_racines, sh->cp_best_perm, sh->nb_nodes * sizeof(int));
+    sh->cp->save(sh->cp->user, etat, taille);
+    free(etat);
+}
+
+/* Relit l'état de reprise : racines terminées et meilleure permutation ; 0 s'il ne
+ * correspond pas à cette recherche (autre dimension ou autre découpage) */
+static int checkpoint_restore(BF_Shared *sh) {
+    const BF_Checkpoint *cp = sh->cp;
+    BF_Etat e;
+    if (!cp->reprise || cp->reprise_taille < sizeof(e)) return 0;
+    memcpy(&e, cp->reprise, sizeof(e));
+    if (e.nb_nodes != sh->nb_nodes || e.prefix_len != sh->racine_len || e.nb_racines != sh->nb_racines ||
+        cp->reprise_taille != sizeof(e) + sh->nb_racines + sh->nb_nodes * sizeof(int))
+        return 0;
+
+    const unsigned char *fait = (const unsigned char *)cp->reprise + sizeof(e);
+    const int *perm = (const int *)(fait + sh->nb_racines);
+    for (int i = 0; i < sh->nb_nodes; ++i)
+        if (perm[i] < 0 || perm[i] >= sh->nb_nodes) return 0;
+    for (int r = 0; r < sh->nb_racines; ++r)
+        atomic_init(&sh->restant[r], fait[r] ? 0 : 1);
+    sh->cp_best_cost = e.best_cost;
+    memcpy(sh->cp_best_perm, perm, sh->nb_nodes * sizeof(int));
+    return 1;
+}
 
-        if (!used[i]) {
-            perm[pos] = i;
-            used[i] = true;
+static void *worker_main(void *arg) {
+    BF_Worker *w = arg;
+    BF_Shared *sh = w->sh;
+    int is_idle = 0;
 
-            permute(nb_nodes, pos + 1, perm, used, best_perm, count_best, cout);
+    while (!stop_requested && !atomic_load(&sh->arret)) {
+        BF_Task t;
+        int got = deque_pop(&sh->deques[w->id], &t);
 
-            used[i] = false;
+        for (int k = 1; !got && k < sh->nb_workers; ++k)
+            got = deque_steal(&sh->deques[(w->id + k) % sh->nb_workers], &t);
 
-            if (stop_requested)
-                return;
+        if (!got) {
+            if (atomic_load(&sh->pending) == 0)
+                break;
+            if (!is_idle) {
+                atomic_fetch_add(&sh->idle, 1);
+                is_idle = 1;
+            }
+            sched_yield();
+            continue;
+        }
+
+        if (is_idle) {
+            atomic_fetch_sub(&sh->idle, 1);
+            is_idle = 0;
+        }
+
+        run_task(w, &t);
+        atomic_fetch_sub(&sh->pending, 1);
+
+        // Tâche menée à son terme (pas d'arrêt pendant son exploration)
+        if (sh->cp && !stop_requested && !atomic_load(&sh->arret)) {
+            atomic_fetch_sub(&sh->restant[t.racine], 1);
+            if (pthread_mutex_trylock(&sh->cp_lock) == 0) {
+                if (wall_seconds() >= sh->prochaine_sauvegarde) {
+                    checkpoint_save(sh);
+                    sh->prochaine_sauvegarde = wall_seconds() + sh->periode;
+                }
+                pthread_mutex_unlock(&sh->cp_lock);
+            }
         }
     }
+
+    if (is_idle)
+        atomic_fetch_sub(&sh->idle, 1);
+    return NULL;
 }
 
-double brute(int nb_nodes,
-             int nb_ressources,
-             int *best_perm,
-             unsigned long long *count_best,
-             void *(*cout)(void *, int *)) {
+/* Génère récursivement les préfixes initiaux de longueur len, répartis tour à tour */
+static void seed_tasks(BF_Shared *sh, BF_Task *t, bool *used, int len, int *next_worker) {
+    if (t->len == len) {
+        t->racine = sh->racine_suivante++;
+        if (sh->restant && atomic_load(&sh->restant[t->racine]) == 0)
+            return;     /* racine déjà explorée (reprise) */
+        atomic_fetch_add(&sh->pending, 1);
+        if (!deque_push(&sh->deques[*next_worker], t))
+            atomic_fetch_sub(&sh->pending, 1);
+        *next_worker = (*next_worker + 1) % sh->nb_workers;
+        return;
+    }
+    // ordre inverse : chaque worker dépile ses tâches par le bas, les plus petits préfixes
+    // d'abord, comme la recherche séquentielle (meilleure solution trouvée plus tôt)
+    for (int i = sh->nb_nodes - 1; i >= 0; --i) {
+        if (used[i]) continue;
+        used[i] = true;
+        t->prefix[t->len++] = i;
+        seed_tasks(sh, t, used, len, next_worker);
+        t->len--;
+        used[i] = false;
+    }
+}
+
+/* Retourne 0 si les ressources n'ont pu être allouées */
+static int run_search(int nb_nodes, int nb_workers, int *best_perm,
+                      unsigned long long *count_best, const BF_Hooks *hooks, void *ctx,
+                      BF_Checkpoint *cp) {
+    BF_Shared sh;
+    sh.nb_nodes = nb_nodes;
+    sh.nb_workers = nb_workers;
+    sh.hooks = hooks;
+    sh.ctx = ctx;
+    sh.cp = cp;
+    sh.restant = NULL;
+    sh.cp_best_perm = NULL;
+    sh.racine_suivante = 0;
+    atomic_init(&sh.pending, 0);
+    atomic_init(&sh.idle, 0);
+    atomic_init(&sh.arret, 0);
+    atomic_init(&sh.best_cost, ~0ULL);
+
+    sh.deques = NULL;
+    BF_Worker *workers = calloc(nb_workers, sizeof(BF_Worker));
+    int ok = (workers != NULL);
+
+    for (int k = 0; ok && k < nb_workers; ++k) {
+        BF_Worker *w = &workers[k];
+        w->sh = &sh;
+        w->id = k;
+        w->perm = malloc(nb_nodes * sizeof(int));
+        w->used = calloc(nb_nodes, sizeof(bool));
+        w->prefix_cost = calloc(nb_nodes + 1, sizeof(unsigned long long));
+        w->best_perm = malloc(nb_nodes * sizeof(int));
+        w->best_cost = ~0ULL;
+        ok = (w->perm && w->used && w->prefix_cost && w->best_perm);
+    }
+
+    if (ok && nb_workers == 1 && !cp) {
+        search(&workers[0], 0);
+
+    } else if (ok) {
+        // Longueur de préfixe : assez de tâches pour occuper tous les workers ; avec
+        // sauvegarde, un découpage fixe pour pouvoir reprendre avec d'autres threads
+        int max_depth = (nb_nodes - 1 < BF_MAX_PREFIX) ? nb_nodes - 1 : BF_MAX_PREFIX;
+        double vise = cp ? BF_RACINES_SAUVEGARDE : (double)nb_workers * BF_TACHES_PAR_THREAD;
+        int len = 1;
+        double nb_tasks = nb_nodes;
+        while (len < max_depth && nb_tasks < vise) {
+            nb_tasks *= nb_nodes - len;
+            len++;
+        }
+        sh.split_depth = max_depth;
+        sh.racine_len = len;
+        sh.nb_racines = (int)nb_tasks;
+
+        sh.deques = calloc(nb_workers, sizeof(BF_Deque));
+        bool *used = calloc(nb_nodes, sizeof(bool));
+        ok = (sh.deques && used);
+
+        if (ok && cp) {
+            sh.restant = malloc(sh.nb_racines * sizeof(atomic_int));
+            sh.cp_best_perm = malloc(nb_nodes * sizeof(int));
+            ok = (sh.restant && sh.cp_best_perm);
+        }
+        if (ok && cp) {
+            pthread_mutex_init(&sh.cp_lock, NULL);
+            sh.periode = cp->periode > 0 ? cp->periode : BF_PERIODE_SAUVEGARDE;
+            sh.prochaine_sauvegarde = wall_seconds() + sh.periode;
+            cp->repris = checkpoint_restore(&sh);
+            if (cp->repris) {
+                // l'incumbent sauvegardé élague dès le départ et participe à la fusion
+                atomic_store(&sh.best_cost, sh.cp_best_cost);
+                workers[0].best_cost = sh.cp_best_cost;
+                memcpy(workers[0].best_perm, sh.cp_best_perm, nb_nodes * sizeof(int));
+            } else {
+                for (int r = 0; r < sh.nb_racines; ++r)
+                    atomic_init(&sh.restant[r], 1);
+                sh.cp_best_cost = ~0ULL;
+                for (int i = 0; i < nb_nodes; ++i)
+                    sh.cp_best_perm[i] = i;
+            }
+        }
+
+        if (ok) {
+            for (int k = 0; k < nb_workers; ++k)
+                pthread_mutex_init(&sh.deques[k].lock, NULL);
 
-    (void)nb_ressources;
+            BF_Task t;
+            t.len = 0;
+            int next_worker = 0;
+            seed_tasks(&sh, &t, used, len, &next_worker);
+
+            int started = 0;
+            for (int k = 0; k < nb_workers; ++k) {
+                if (pthread_create(&workers[k].thread, NULL, worker_main, &workers[k]) != 0)
+                    break;
+                started++;
+            }
+
+            // Aucun thread créé : le thread appelant fait tout le travail (les autres deques sont volées)
+            if (started == 0)
+                worker_main(&workers[0]);
+            for (int k = 0; k < started; ++k)
+                pthread_join(workers[k].thread, NULL);
+
+            for (int k = 0; k < nb_workers; ++k) {
+                pthread_mutex_destroy(&sh.deques[k].lock);
+                free(sh.deques[k].tasks);
+            }
+            // état final : toutes les racines terminées, ou reprise possible après l'arrêt
+            if (cp) {
+                checkpoint_save(&sh);
+                pthread_mutex_destroy(&sh.cp_lock);
+            }
+        }
+        free(used);
+    }
+
+    // Fusion des meilleurs résultats locaux
+    for (int k = 0; ok && k < nb_workers; ++k) {
+        BF_Worker *w = &workers[k];
+        if (precedes(w->best_cost, w->best_perm, *count_best, best_perm, nb_nodes)) {
+            *count_best = w->best_cost;
+            memcpy(best_perm, w->best_perm, nb_nodes * sizeof(int));
+        }
+    }
+
+    for (int k = 0; workers && k < nb_workers; ++k) {
+        free(workers[k].perm);
+        free(workers[k].used);
+        free(workers[k].prefix_cost);
+        free(workers[k].best_perm);
+    }
+    free(workers);
+    free(sh.deques);
+    free(sh.restant);
+    free(sh.cp_best_perm);
+    return ok;
+}
+
+double brute_incr(int nb_nodes,
+                  int nb_ressources,
+                  int *best_perm,
+                  unsigned long long *count_best,
+                  const BF_Hooks *hooks,
+                  void *ctx) {
+    return brute_incr_cp(nb_nodes, nb_ressources, best_perm, count_best, hooks, ctx, NULL);
+}
+
+double brute_incr_cp(int nb_nodes,
+                     int nb_ressources,
+                     int *best_perm,
+                     unsigned long long *count_best,
+                     const BF_Hooks *hooks,
+                     void *ctx,
+                     BF_Checkpoint *cp) {
 
-    int *perm = malloc(nb_nodes * sizeof(int));
-    bool *used = calloc(nb_nodes, sizeof(bool));
     *count_best = ~0ULL;
+    if (cp) cp->repris = 0;
+    if (nb_nodes <= 0 || !hooks)
+        return (double)(*count_best);
 
-    permute(nb_nodes, 0, perm, used, best_perm, count_best, cout);
+    // trop peu d'éléments pour découper en tâches : recherche directe, sans sauvegarde
+    if (nb_nodes < 3 || (cp && !cp->save))
+        cp = NULL;
 
-    free(perm);
-    free(used);
+    // nb_ressources = nombre de threads de calcul ; repli séquentiel si l'allocation échoue
+    int nb_workers = (nb_ressources > 1 && nb_nodes >= 3) ? nb_ressources : 1;
+    if (!run_search(nb_nodes, nb_workers, best_perm, count_best, hooks, ctx, cp) && nb_workers > 1)
+        run_search(nb_nodes, 1, best_perm, count_best, hooks, ctx, cp);
 
     return (double)(*count_best);
 }
+
+/* Adaptateur de l'ancienne API : tout le coût est calculé à la fin par cout */
+
+typedef struct {
+    void *(*cout)(void *, int *);
+} BF_Legacy;
+
+static unsigned long long legacy_close(void *ctx, const int *perm, int n) {
+    (void)n;
+    BF_Legacy *lg = ctx;
+    void *res = lg->cout(NULL, (int *)perm);
+    if (res == NULL)
+        return BF_INFEASIBLE;
+    unsigned long long cost = *(unsigned long long *)res;
+    free(res);
+    return cost;
+}
+
+double brute(int nb_nodes,
+             int nb_ressources,
+             int *best_perm,
+             unsigned long long *count_best,
+             void *(*cout)(void *, int *)) {
+
+    BF_Legacy lg = { cout };
+    BF_Hooks hooks = { NULL, NULL, legacy_close, NULL, NULL };
+    return brute_incr(nb_nodes, nb_ressources, best_perm, count_best, &hooks, &lg);
+}
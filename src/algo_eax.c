@@ -0,0 +1,459 @@
+/* algo_eax.c
+ * Edge Assembly Crossover (EAX) pour l'algorithme génétique.
+ * 1. Union des arêtes des parents A et B (arêtes communes exclues) décomposée
+ *    en AB-cycles : cycles alternant une arête de A et une arête de B.
+ * 2. E-set = un AB-cycle : on retire de A ses arêtes de A et on ajoute ses arêtes de B.
+ * 3. Les sous-tours obtenus sont fusionnés un à un par échange de deux arêtes
+ *    (recherche limitée aux k plus proches voisins), sans passe 2-opt.
+ * Plusieurs E-sets sont essayés ; l'enfant retenu n'est jamais pire que A.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "algo_eax.h"
+#include "neighbors.h"
+#include "algo_ga.h"
+
+#define EAX_NB_VOISINS 10   /* candidats pour la fusion des sous-tours */
+#define EAX_NB_ESSAIS  10   /* E-sets évalués par croisement */
+
+struct EAX_Workspace {
+    const TSP_Instance *inst;
+    int n;
+    int k;
+    int *neigh;              /* n*k plus proches voisins */
+
+    int *adj_a;              /* 2n : les deux voisins de chaque ville dans A */
+    int *adj_b;              /* 2n : idem dans B */
+    int *rem_a, *cnt_a;      /* arêtes de A \ B non encore placées dans un AB-cycle */
+    int *rem_b, *cnt_b;      /* arêtes de B \ A */
+
+    int *path;               /* 2n+1 : chemin alterné en cours de construction */
+    int *pos_even;           /* n : indice pair de la ville dans path, -1 sinon */
+    int *pos_odd;            /* n : indice impair de la ville dans path, -1 sinon */
+
+    int *cyc_nodes;          /* 2n : villes des AB-cycles, concaténées */
+    int *cyc_start;          /* n : début de chaque cycle dans cyc_nodes */
+    int *cyc_len;            /* n : nombre d'arêtes du cycle */
+    int *cyc_order;          /* n : ordre de tirage des E-sets */
+    int ncyc;
+
+    int *adj_c;              /* 2n : enfant intermédiaire */
+    int *adj_best;           /* 2n : meilleur enfant trouvé */
+    int *sub_id;             /* n : sous-tour de chaque ville */
+    int *sub_size;           /* n : taille de chaque sous-tour */
+    int *sub_rep;            /* n : une ville de chaque sous-tour */
+    int *sub_list;           /* n : villes du sous-tour en cours de fusion */
+};
+
+/* Candidat de fusion : on retire (u,u1) et (v,v1), on ajoute (u,v),(u1,v1) ou (u,v1),(u1,v) */
+typedef struct {
+    double delta;
+    int u, u1, v, v1;
+    int cross;
+} Merge_Move;
+
+static inline double D(const EAX_Workspace *ws, int i, int j) {
+    return ws->inst->dist[(size_t)i * ws->n + j];
+}
+
+static inline int has_edge(const int *adj, int u, int v) {
+    return adj[2 * u] == v || adj[2 * u + 1] == v;
+}
+
+/* Remplace le voisin old de u par nw (old = -1 pour remplir une case libre) */
+static inline void replace_link(int *adj, int u, int old, int nw) {
+    if (adj[2 * u] == old) adj[2 * u] = nw;
+    else adj[2 * u + 1] = nw;
+}
+
+/* Voisin suivant de cur quand on arrive depuis prev */
+static inline int next_city(const int *adj, int cur, int prev) {
+    return (adj[2 * cur] != prev) ? adj[2 * cur] : adj[2 * cur + 1];
+}
+
+static void perm_to_adj(const int *perm, int n, int *adj) {
+    for (int i = 0; i < n; ++i) {
+        int u = perm[i];
+        adj[2 * u]     = perm[(i + n - 1) % n];
+        adj[2 * u + 1] = perm[(i + 1) % n];
+    }
+}
+
+static void adj_to_perm(const int *adj, int start, int n, int *perm) {
+    int prev = adj[2 * start + 1];
+    int cur = start;
+    for (int i = 0; i < n; ++i) {
+        perm[i] = cur;
+        int nx = next_city(adj, cur, prev);
+        prev = cur;
+        cur = nx;
+    }
+}
+
+static void rem_delete(int *rem, int *cnt, int u, int v) {
+    for (int r = 0; r < cnt[u]; ++r) {
+        if (rem[2 * u + r] == v) {
+            rem[2 * u + r] = rem[2 * u + cnt[u] - 1];
+            cnt[u]--;
+            return;
+        }
+    }
+}
+
+/* Construction des AB-cycles */
+
+static void build_ab_cycles(EAX_Workspace *ws) {
+    int n = ws->n;
+    int *path = ws->path;
+
+    for (int u = 0; u < n; ++u) {
+        ws->cnt_a[u] = ws->cnt_b[u] = 0;
+        for (int s = 0; s < 2; ++s) {
+            int va = ws->adj_a[2 * u + s];
+            int vb = ws->adj_b[2 * u + s];
+            if (!has_edge(ws->adj_b, u, va)) ws->rem_a[2 * u + ws->cnt_a[u]++] = va;
+            if (!has_edge(ws->adj_a, u, vb)) ws->rem_b[2 * u + ws->cnt_b[u]++] = vb;
+        }
+    }
+
+    ws->ncyc = 0;
+    int total = 0;
+    int offset = ga_rand() % n;
+
+    for (int t = 0; t < n; ++t) {
+        int s = (t + offset) % n;
+        if (ws->cnt_a[s] == 0) continue;
+
+        // Marche alternée : indice pair -> arête de A, indice impair -> arête de B.
+        // Chaque ville a autant d'arêtes A que B restantes : la marche ne bloque jamais.
+        int L = 0, cur = s;
+        path[0] = s;
+        ws->pos_even[s] = 0;
+
+        while (!(L == 0 && ws->cnt_a[cur] == 0)) {
+            int *rem = (L & 1) ? ws->rem_b : ws->rem_a;
+            int *cnt = (L & 1) ? ws->cnt_b : ws->cnt_a;
+            int nxt = rem[2 * cur + ga_rand() % cnt[cur]];
+            rem_delete(rem, cnt, cur, nxt);
+            rem_delete(rem, cnt, nxt, cur);
+            path[++L] = nxt;
+
+            int *pos = (L & 1) ? ws->pos_odd : ws->pos_even;
+            if (pos[nxt] < 0) {
+                pos[nxt] = L;
+                cur = nxt;
+                continue;
+            }
+
+            // Fermeture d'un AB-cycle path[st..L] ; on le stocke en commençant par une arête de A
+            int st = pos[nxt];
+            int len = L - st;
+            int first = (st & 1) ? st + 1 : st;
+            int *c = ws->cyc_nodes + total;
+            for (int j = 0; j < len; ++j) {
+                int p = first + j;
+                if (p >= L) p -= len;
+                c[j] = path[p];
+            }
+            ws->cyc_start[ws->ncyc] = total;
+            ws->cyc_len[ws->ncyc] = len;
+            ws->ncyc++;
+            total += len;
+
+            for (int j = st + 1; j < L; ++j) {
+                if (j & 1) ws->pos_odd[path[j]] = -1;
+                else       ws->pos_even[path[j]] = -1;
+            }
+            L = st;
+            cur = nxt;
+        }
+        ws->pos_even[s] = -1;
+    }
+}
+
+/* Applique l'E-set c_idx à A dans adj_c ; retourne la variation de longueur */
+
+static double apply_eset(EAX_Workspace *ws, int c_idx) {
+    int n = ws->n;
+    const int *c = ws->cyc_nodes + ws->cyc_start[c_idx];
+    int len = ws->cyc_len[c_idx];
+    double delta = 0.0;
+
+    memcpy(ws->adj_c, ws->adj_a, 2 * n * sizeof(int));
+
+    // D'abord retirer les arêtes de A (indices pairs), puis ajouter celles de B
+    for (int j = 0; j < len; j += 2) {
+        int u = c[j], v = c[(j + 1) % len];
+        replace_link(ws->adj_c, u, v, -1);
+        replace_link(ws->adj_c, v, u, -1);
+        delta -= D(ws, u, v);
+    }
+    for (int j = 1; j < len; j += 2) {
+        int u = c[j], v = c[(j + 1) % len];
+        replace_link(ws->adj_c, u, -1, v);
+        replace_link(ws->adj_c, v, -1, u);
+        delta += D(ws, u, v);
+    }
+    return delta;
+}
+
+static int label_subtours(EAX_Workspace *ws) {
+    int n = ws->n;
+    int nsub = 0;
+
+    for (int v = 0; v < n; ++v)
+        ws->sub_id[v] = -1;
+
+    for (int v = 0; v < n; ++v) {
+        if (ws->sub_id[v] >= 0) continue;
+        int size = 0, prev = ws->adj_c[2 * v + 1], cur = v;
+        do {
+            ws->sub_id[cur] = nsub;
+            size++;
+            int nx = next_city(ws->adj_c, cur, prev);
+            prev = cur;
+            cur = nx;
+        } while (cur != v);
+        ws->sub_size[nsub] = size;
+        ws->sub_rep[nsub] = v;
+        nsub++;
+    }
+    return nsub;
+}
+
+static void eval_merge(const EAX_Workspace *ws, int u, int u1, double d_uu1, int v, Merge_Move *mv) {
+    for (int s = 0; s < 2; ++s) {
+        int v1 = ws->adj_c[2 * v + s];
+        double base = -d_uu1 - D(ws, v, v1);
+        double d1 = base + D(ws, u, v) + D(ws, u1, v1);
+        double d2 = base + D(ws, u, v1) + D(ws, u1, v);
+        if (d1 < mv->delta) {
+            mv->delta = d1; mv->u = u; mv->u1 = u1; mv->v = v; mv->v1 = v1; mv->cross = 0;
+        }
+        if (d2 < mv->delta) {
+            mv->delta = d2; mv->u = u; mv->u1 = u1; mv->v = v; mv->v1 = v1; mv->cross = 1;
+        }
+    }
+}
+
+/* Fusionne les sous-tours (le plus petit d'abord) ; retourne la variation de longueur */
+
+static double merge_subtours(EAX_Workspace *ws, int nsub) {
+    double total = 0.0;
+    int remaining = nsub;
+
+    while (remaining > 1) {
+        int U = -1;
+        for (int s = 0; s < nsub; ++s)
+            if (ws->sub_size[s] > 0 && (U < 0 || ws->sub_size[s] < ws->sub_size[U]))
+                U = s;
+
+        int m = 0, v0 = ws->sub_rep[U], prev = ws->adj_c[2 * v0 + 1], cur = v0;
+        do {
+            ws->sub_list[m++] = cur;
+            int nx = next_city(ws->adj_c, cur, prev);
+            prev = cur;
+            cur = nx;
+        } while (cur != v0);
+
+        Merge_Move mv;
+        mv.delta = 1e300;
+        mv.u = -1;
+
+        for (int i = 0; i < m; ++i) {
+            int u = ws->sub_list[i];
+            int u1 = ws->sub_list[(i + 1) % m];
+            double d_uu1 = D(ws, u, u1);
+            const int *nb = ws->neigh + (size_t)u * ws->k;
+            for (int r = 0; r < ws->k; ++r)
+                if (ws->sub_id[nb[r]] != U)
+                    eval_merge(ws, u, u1, d_uu1, nb[r], &mv);
+        }
+
+        // Aucun candidat hors du sous-tour : recherche sur toutes les villes
+        if (mv.u < 0) {
+            for (int i = 0; i < m; ++i) {
+                int u = ws->sub_list[i];
+                int u1 = ws->sub_list[(i + 1) % m];
+                double d_uu1 = D(ws, u, u1);
+                for (int v = 0; v < ws->n; ++v)
+                    if (ws->sub_id[v] != U)
+                        eval_merge(ws, u, u1, d_uu1, v, &mv);
+            }
+        }
+
+        if (mv.cross == 0) {
+            replace_link(ws->adj_c, mv.u, mv.u1, mv.v);
+            replace_link(ws->adj_c, mv.u1, mv.u, mv.v1);
+            replace_link(ws->adj_c, mv.v, mv.v1, mv.u);
+            replace_link(ws->adj_c, mv.v1, mv.v, mv.u1);
+        } else {
+            replace_link(ws->adj_c, mv.u, mv.u1, mv.v1);
+            replace_link(ws->adj_c, mv.u1, mv.u, mv.v);
+            replace_link(ws->adj_c, mv.v, mv.v1, mv.u1);
+            replace_link(ws->adj_c, mv.v1, mv.v, mv.u);
+        }
+
+        int T = ws->sub_id[mv.v];
+        for (int i = 0; i < m; ++i)
+            ws->sub_id[ws->sub_list[i]] = T;
+        ws->sub_size[T] += m;
+        ws->sub_size[U] = 0;
+        remaining--;
+        total += mv.delta;
+    }
+    return total;
+}
+
+/* API */
+
+EAX_Workspace *eax_create(const TSP_Instance *inst) {
+    if (!inst || inst->dimension < 3 || !inst->dist) return NULL;
+
+    int n = inst->dimension;
+    EAX_Workspace *ws = calloc(1, sizeof(EAX_Workspace));
+    if (!ws) return NULL;
+
+    ws->inst = inst;
+    ws->n = n;
+    ws->neigh = build_neighbor_lists(inst, EAX_NB_VOISINS, &ws->k);
+
+    ws->adj_a     = malloc(2 * n * sizeof(int));
+    ws->adj_b     = malloc(2 * n * sizeof(int));
+    ws->rem_a     = malloc(2 * n * sizeof(int));
+    ws->rem_b     = malloc(2 * n * sizeof(int));
+    ws->cnt_a     = malloc(n * sizeof(int));
+    ws->cnt_b     = malloc(n * sizeof(int));
+    ws->path      = malloc((2 * n + 1) * sizeof(int));
+    ws->pos_even  = malloc(n * sizeof(int));
+    ws->pos_odd   = malloc(n * sizeof(int));
+    ws->cyc_nodes = malloc(2 * n * sizeof(int));
+    ws->cyc_start = malloc(n * sizeof(int));
+    ws->cyc_len   = malloc(n * sizeof(int));
+    ws->cyc_order = malloc(n * sizeof(int));
+    ws->adj_c     = malloc(2 * n * sizeof(int));
+    ws->adj_best  = malloc(2 * n * sizeof(int));
+    ws->sub_id    = malloc(n * sizeof(int));
+    ws->sub_size  = malloc(n * sizeof(int));
+    ws->sub_rep   = malloc(n * sizeof(int));
+    ws->sub_list  = malloc(n * sizeof(int));
+
+    if (!ws->neigh || !ws->adj_a || !ws->adj_b || !ws->rem_a || !ws->rem_b ||
+        !ws->cnt_a || !ws->cnt_b || !ws->path || !ws->pos_even || !ws->pos_odd ||
+        !ws->cyc_nodes || !ws->cyc_start || !ws->cyc_len || !ws->cyc_order ||
+        !ws->adj_c || !ws->adj_best || !ws->sub_id || !ws->sub_size ||
+        !ws->sub_rep || !ws->sub_list) {
+        eax_free(ws);
+        return NULL;
+    }
+
+    for (int i = 0; i < n; ++i)
+        ws->pos_even[i] = ws->pos_odd[i] = -1;
+
+    return ws;
+}
+
+void eax_free(EAX_Workspace *ws) {
+    if (!ws) return;
+    free(ws->neigh);
+    free(ws->adj_a);
+    free(ws->adj_b);
+    free(ws->rem_a);
+    free(ws->rem_b);
+    free(ws->cnt_a);
+    free(ws->cnt_b);
+    free(ws->path);
+    free(ws->pos_even);
+    free(ws->pos_odd);
+    free(ws->cyc_nodes);
+    free(ws->cyc_start);
+    free(ws->cyc_len);
+    free(ws->cyc_order);
+    free(ws->adj_c);
+    free(ws->adj_best);
+    free(ws->sub_id);
+    free(ws->sub_size);
+    free(ws->sub_rep);
+    free(ws->sub_list);
+    free(ws);
+}
+
+void eax_init_tour(EAX_Workspace *ws, int *perm) {
+    int n = ws->n;
+    int *visited = ws->sub_id;   /* tampon libre entre deux croisements */
+
+    for (int i = 0; i < n; ++i)
+        visited[i] = 0;
+
+    int cur = ga_rand() % n;
+    perm[0] = cur;
+    visited[cur] = 1;
+
+    for (int i = 1; i < n; ++i) {
+        // Premier candidat libre, parfois le second pour diversifier la population
+        int next = -1;
+        int skip = (ga_rand() % 10 == 0);
+        const int *nb = ws->neigh + (size_t)cur * ws->k;
+        for (int r = 0; r < ws->k; ++r) {
+            if (visited[nb[r]]) continue;
+            next = nb[r];
+            if (skip-- == 0) break;
+        }
+
+        // Tous les candidats sont visités : plus proche voisin exact
+        if (next < 0) {
+            double best = 0.0;
+            for (int v = 0; v < n; ++v)
+                if (!visited[v] && (next < 0 || D(ws, cur, v) < best)) {
+                    best = D(ws, cur, v);
+                    next = v;
+                }
+        }
+        perm[i] = next;
+        visited[next] = 1;
+        cur = next;
+    }
+}
+
+double eax_crossover(EAX_Workspace *ws, const int *pa, double len_a, const int *pb, int *child) {
+    int n = ws->n;
+
+    perm_to_adj(pa, n, ws->adj_a);
+    perm_to_adj(pb, n, ws->adj_b);
+    build_ab_cycles(ws);
+
+    int ncyc = ws->ncyc;
+    int essais = (ncyc < EAX_NB_ESSAIS) ? ncyc : EAX_NB_ESSAIS;
+    double best_len = len_a;
+    int found = 0;
+
+    for (int c = 0; c < ncyc; ++c)
+        ws->cyc_order[c] = c;
+
+    for (int t = 0; t < essais; ++t) {
+        // Tirage sans remise des E-sets
+        int r = t + ga_rand() % (ncyc - t);
+        int tmp = ws->cyc_order[t];
+        ws->cyc_order[t] = ws->cyc_order[r];
+        ws->cyc_order[r] = tmp;
+
+        double len = len_a + apply_eset(ws, ws->cyc_order[t]);
+        int nsub = label_subtours(ws);
+        if (nsub > 1)
+            len += merge_subtours(ws, nsub);
+
+        if (len < best_len) {
+            best_len = len;
+            memcpy(ws->adj_best, ws->adj_c, 2 * n * sizeof(int));
+            found = 1;
+        }
+    }
+
+    if (found)
+        adj_to_perm(ws->adj_best, pa[0], n, child);
+    else
+        memcpy(child, pa, n * sizeof(int));
+
+    return best_len;
+}
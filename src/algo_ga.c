@@ -6,14 +6,31 @@
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
-#include <signal.h>
+#include <math.h>
 
 #include "algo_ga.h"
 #include "algo_2opt.h"
+#include "algo_eax.h"
+#include "algo_gpx.h"
+#include "tour_cache.h"
+#include "stats.h"
+#include "ga_trace.h"
+#include "thread_pool.h"
 #include "tsp_parser.h"
+#include "tour_io.h"
 
-/* Variable globale provenant de main.c */
-extern volatile sig_atomic_t stop_requested;
+/* Cache 2-opt (mode DPX) : 4 entrées par individu, 64 Mo au plus */
+#define GA_CACHE_SLOTS_PAR_INDIVIDU 4
+#define GA_CACHE_MAX_OCTETS ((size_t)64 << 20)
+
+/* Nombre de tentatives avant d'accepter un enfant en double */
+#define GA_MAX_REJETS 5
+
+/* Trace de convergence : lignes en attente d'écriture au plus */
+#define GA_TRACE_CAPACITE 4096
+
+/* Sauvegarde de l'état (voir GA_Suivi.checkpoint) */
+#define GA_CK_TYPE "GA01"
 
 /*Type interne pour un individu  */
 
@@ -25,8 +42,14 @@ typedef struct {
 
 /* Outils aléatoires */
 
+static _Thread_local unsigned int ga_graine;
+
+int ga_rand(void) {
+    return rand_r(&ga_graine);
+}
+
 static int rand_int(int a, int b) {
-    return a + rand() % (b - a + 1);
+    return a + ga_rand() % (b - a + 1);
 }
 
 /* Longueur d'une permutation (tour TSP) */
@@ -60,19 +83,118 @@ static void generate_random_perm(int *perm, int n) {
     }
 }
 
-/* Mutation swap  */
+/* Mutations : chaque opérateur retourne la variation de longueur (calculée en O(1)
+ * à partir des arêtes touchées), ce qui évite de réévaluer la tournée complète. */
+
+static inline double D(const TSP_Instance *inst, int u, int v) {
+    return inst->dist[u * inst->dimension + v];
+}
+
+/* Variation de longueur si l'on échange les positions i et j */
+static double swap_delta(const TSP_Instance *inst, const int *perm, int n, int i, int j) {
+    if (i == j || n < 3) return 0.0;
+    if (i > j) { int t = i; i = j; j = t; }
+
+    int a = perm[i], b = perm[j];
+    int pa = perm[(i + n - 1) % n], na = perm[(i + 1) % n];
+    int pb = perm[(j + n - 1) % n], nb = perm[(j + 1) % n];
+
+    if (j == i + 1)                 /* ... pa a b nb ... */
+        return D(inst, pa, b) + D(inst, a, nb) - D(inst, pa, a) - D(inst, b, nb);
+    if (i == 0 && j == n - 1)       /* ... pb b | a na ... (adjacents par le bouclage) */
+        return D(inst, pb, a) + D(inst, b, na) - D(inst, pb, b) - D(inst, a, na);
+
+    return D(inst, pa, b) + D(inst, b, na) + D(inst, pb, a) + D(inst, a, nb)
+         - D(inst, pa, a) - D(inst, a, na) - D(inst, pb, b) - D(inst, b, nb);
+}
 
-static void swap_mutation(int *perm, int n, double mutation_rate) {
+/* Mutation swap */
+
+static double swap_mutation(const TSP_Instance *inst, int *perm, int n, double mutation_rate) {
+    double delta = 0.0;
     for (int i = 0; i < n; ++i) {
-        if ((double)rand() / RAND_MAX < mutation_rate) {
+        if ((double)ga_rand() / RAND_MAX < mutation_rate) {
             int j = rand_int(0, n - 1);
+            delta += swap_delta(inst, perm, n, i, j);
             int tmp = perm[i];
             perm[i] = perm[j];
             perm[j] = tmp;
         }
     }
+    return delta;
+}
+
+/* Mutation inversion : renverse perm[i..j], seules les deux arêtes aux bords changent */
+
+static double inversion_mutation(const TSP_Instance *inst, int *perm, int n, double mutation_rate) {
+    double delta = 0.0;
+    for (int g = 0; g < n; ++g) {
+        if ((double)ga_rand() / RAND_MAX < mutation_rate) {
+            int i = g, j = rand_int(0, n - 1);
+            if (i > j) { int t = i; i = j; j = t; }
+            if (i == j || (i == 0 && j == n - 1)) continue;
+
+            int prev = perm[(i + n - 1) % n], next = perm[(j + 1) % n];
+            delta += D(inst, prev, perm[j]) + D(inst, perm[i], next)
+                   - D(inst, prev, perm[i]) - D(inst, perm[j], next);
+
+            while (i < j) {
+                int tmp = perm[i];
+                perm[i++] = perm[j];
+                perm[j--] = tmp;
+            }
+        }
+    }
+    return delta;
+}
+
+/* Mutation insertion : la ville en position i est déplacée entre perm[j] et perm[j+1] */
+
+static double insertion_mutation(const TSP_Instance *inst, int *perm, int n, double mutation_rate) {
+    double delta = 0.0;
+    if (n < 4) return 0.0;
+
+    for (int i = 0; i < n; ++i) {
+        if ((double)ga_rand() / RAND_MAX < mutation_rate) {
+            int j = rand_int(0, n - 1);
+            if (j == i || j == (i + n - 1) % n) continue;
+
+            int c = perm[i];
+            int p = perm[(i + n - 1) % n], nx = perm[(i + 1) % n];
+            int x = perm[j], y = perm[(j + 1) % n];
+            delta += D(inst, p, nx) - D(inst, p, c) - D(inst, c, nx)
+                   + D(inst, x, c) + D(inst, c, y) - D(inst, x, y);
+
+            if (i < j) {
+                memmove(&perm[i], &perm[i + 1], (j - i) * sizeof(int));
+                perm[j] = c;
+            } else {
+                memmove(&perm[j + 2], &perm[j + 1], (i - j - 1) * sizeof(int));
+                perm[j + 1] = c;
+            }
+        }
+    }
+    return delta;
+}
+
+static double mutate(const TSP_Instance *inst, int *perm, int n, double mutation_rate, int mutation) {
+    switch (mutation) {
+        case GA_MUT_INVERSION: return inversion_mutation(inst, perm, n, mutation_rate);
+        case GA_MUT_INSERTION: return insertion_mutation(inst, perm, n, mutation_rate);
+        default:               return swap_mutation(inst, perm, n, mutation_rate);
+    }
 }
 
+#ifndef NDEBUG
+/* Mode debug : la fitness incrémentale doit égaler le recalcul complet */
+static void check_fitness(const TSP_Instance *inst, const GA_Individual *ind) {
+    double full = ga_tour_length(inst, ind->perm);
+    if (fabs(full - ind->fitness) > 1e-6 * (1.0 + full))
+        fprintf(stderr, "[GA] fitness incrémentale incohérente : %.3f au lieu de %.3f\n",
+                ind->fitness, full);
+}
+#endif
+
 /* DPX Util: Nearest Segment*/
 
 static int nearest_segment(
@@ -113,43 +235,44 @@ static int nearest_segment(
     return best_seg;
 }
 
-/* Distance preserving crossover (DPX)*/
+/* Distance preserving crossover (DPX)
+ * Retourne la longueur de l'enfant : les arêtes communes aux deux parents sont
+ * reprises avec leur coût, seules les arêtes de raccordement sont ajoutées. */
 
-static void dpx(
+static double dpx(
         const TSP_Instance *inst,
         const int *p1,
         const int *p2,
         int *child,
         int n)
 {
+    double length = 0.0;
+
     /* -------- STEP 1: Find identical edges => build segments ---------- */
+    /* Un segment est une suite contiguë de p1 : on ne garde que son indice de début */
 
-    int **segments = malloc(n * sizeof(int*));
-    int *seg_len = calloc(n, sizeof(int));
+    int *succ2     = malloc(n * sizeof(int));
+    int *seg_first = malloc(n * sizeof(int));
+    int *seg_len   = malloc(n * sizeof(int));
     int seg_count = 0;
 
-    for (int i = 0; i < n; i++) {
-        segments[i] = malloc(n * sizeof(int));
-        for (int j = 0; j < n; j++) segments[i][j] = -1;
-    }
+    for (int j = 0; j < n - 1; j++)
+        succ2[p2[j]] = p2[j + 1];
+    succ2[p2[n - 1]] = -1;
 
-    segments[0][0] = p1[0];
+    seg_first[0] = 0;
     seg_len[0] = 1;
 
     for (int i = 0; i < n-1; i++) {
         int a = p1[i];
         int b = p1[i+1];
 
-        int found = 0;
-        for (int j = 0; j < n-1; j++)
-            if (p2[j] == a && p2[j+1] == b)
-                found = 1;
-
-        if (found) {
-            segments[seg_count][seg_len[seg_count]++] = b;
+        if (succ2[a] == b) {
+            seg_len[seg_count]++;
+            length += D(inst, a, b);
         } else {
             seg_count++;
-            segments[seg_count][0] = b;
+            seg_first[seg_count] = i + 1;
             seg_len[seg_count] = 1;
         }
     }
@@ -162,8 +285,8 @@ static void dpx(
     int *used      = calloc(seg_count, sizeof(int));
 
     for (int s = 0; s < seg_count; s++) {
-        seg_start[s] = segments[s][0];
-        seg_end[s]   = segments[s][seg_len[s] - 1];
+        seg_start[s] = p1[seg_first[s]];
+        seg_end[s]   = p1[seg_first[s] + seg_len[s] - 1];
     }
 
     /* -------- STEP 3: Build the child ---------- */
@@ -172,7 +295,7 @@ static void dpx(
 
     // Always start with segment 0
     for (int j = 0; j < seg_len[0]; j++)
-        child[pos++] = segments[0][j];
+        child[pos++] = p1[j];
     used[0] = 1;
 
     int current_node = seg_end[0];
@@ -181,35 +304,43 @@ static void dpx(
     for (int step = 1; step < seg_count; step++) {
         int rev;
         int best = nearest_segment(inst, current_node, seg_start, seg_end, used, seg_count, &rev);
+        const int *seg = p1 + seg_first[best];
 
         used[best] = 1;
 
         if (!rev) {
+            length += D(inst, current_node, seg_start[best]);
             for (int j = 0; j < seg_len[best]; j++)
-                child[pos++] = segments[best][j];
+                child[pos++] = seg[j];
             current_node = seg_end[best];
         } else {
+            length += D(inst, current_node, seg_end[best]);
             for (int j = seg_len[best]-1; j >= 0; j--)
-                child[pos++] = segments[best][j];
+                child[pos++] = seg[j];
             current_node = seg_start[best];
         }
     }
+    length += D(inst, current_node, child[0]);
 
     /* -------- FREE memory ---------- */
-    for (int s = 0; s < n; s++) free(segments[s]);
-    free(segments);
+    free(succ2);
+    free(seg_first);
     free(seg_len);
     free(seg_start);
     free(seg_end);
     free(used);
+
+    return length;
 }
 
-/* Ordered Crossover (OX) */
+/* Ordered Crossover (OX)
+ * in_child : tampon de n marqueurs fourni par l'appelant. Retourne la longueur de l'enfant,
+ * cumulée pendant le remplissage. */
 
-static void ordered_crossover(const int *p1, const int *p2, int *child, int n) {
+static double ordered_crossover(const TSP_Instance *inst, const int *p1, const int *p2,
+                                int *child, int n, char *in_child) {
 
-    for (int i = 0; i < n; ++i)
-        child[i] = -1;
+    memset(in_child, 0, n);
 
     int start = rand_int(0, n - 1);
     int end   = rand_int(0, n - 1);
@@ -217,24 +348,57 @@ static void ordered_crossover(const int *p1, const int *p2, int *child, int n) {
         int tmp = start; start = end; end = tmp;
     }
 
-    for (int i = start; i <= end; ++i)
+    double length = 0.0;
+    for (int i = start; i <= end; ++i) {
         child[i] = p1[i];
+        in_child[p1[i]] = 1;
+        if (i > start) length += D(inst, child[i - 1], child[i]);
+    }
 
     int idx = (end + 1) % n;
+    int prev = child[end];
 
     for (int k = 0; k < n; ++k) {
         int candidate = p2[(end + 1 + k) % n];
-        int used = 0;
-
-        for (int j = 0; j < n; ++j)
-            if (child[j] == candidate)
-                used = 1;
 
-        if (!used) {
+        if (!in_child[candidate]) {
             child[idx] = candidate;
             idx = (idx + 1) % n;
+            length += D(inst, prev, candidate);
+            prev = candidate;
         }
     }
+
+    /* fermeture : dernière ville placée -> début du segment */
+    return length + D(inst, prev, child[start]);
+}
+
+/* DPX + 2-opt avec cache : un enfant déjà rencontré (même ensemble d'arêtes)
+ * reprend directement l'optimum local mémorisé au lieu de repasser le 2-opt. */
+
+static double dpx_local_search(const TSP_Instance *inst, Tour_Cache *cache,
+                               const int *p1, const int *p2, int *child, int n, Solve_Context *ctx)
+{
+    double fit = dpx(inst, p1, p2, child, n);
+    if (!cache)
+        return fit - improve_2opt_gain(inst, child, ctx);
+
+    uint64_t key = tour_hash(child, n);
+    if (tour_cache_lookup(cache, key, child, &fit))
+        return fit;
+
+    fit -= improve_2opt_gain(inst, child, ctx);
+    /* 2-opt interrompu : pas un optimum local, rien à mémoriser */
+    if (solve_ctx_stop(ctx))
+        return fit;
+    tour_cache_insert(cache, key, child, fit);
+
+    /* l'optimum local est son propre résultat */
+    uint64_t key_opt = tour_hash(child, n);
+    if (key_opt != key)
+        tour_cache_insert(cache, key_opt, child, fit);
+
+    return fit;
 }
 
 /*Sélection par tournoi */
@@ -261,7 +425,121 @@ static void copy_individual(const GA_Individual *src, GA_Individual *dst) {
  * ALGORTIHME GÉNÉTIQUE COMPLET
  */
 
-int* ga_tour(const TSP_Instance *inst, int pop_size, int generations, double mutation_rate, int use_dpx)
+static int cmp_hash(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+/* Ligne de trace de la population courante ; diversité = tournées distinctes (empreintes) */
+static void trace_generation(GA_Trace *trace, int gen, const GA_Individual *pop, int pop_size,
+                             uint64_t *hashes, double t0) {
+    GA_Trace_Entry e;
+    e.generation = gen;
+    e.best = e.worst = pop[0].fitness;
+    double sum = 0.0;
+    for (int i = 0; i < pop_size; ++i) {
+        if (pop[i].fitness < e.best) e.best = pop[i].fitness;
+        if (pop[i].fitness > e.worst) e.worst = pop[i].fitness;
+        sum += pop[i].fitness;
+        hashes[i] = tour_hash(pop[i].perm, pop[i].n);
+    }
+    e.mean = sum / pop_size;
+
+    qsort(hashes, pop_size, sizeof(uint64_t), cmp_hash);
+    int distinct = 1;
+    for (int i = 1; i < pop_size; ++i)
+        distinct += (hashes[i] != hashes[i - 1]);
+    e.diversity = (double)distinct / pop_size;
+    e.elapsed = wall_seconds() - t0;
+    ga_trace_push(trace, &e);
+}
+
+/* Sauvegarde : cet entête, puis le meilleur individu et la population (fitness, permutation).
+ * gen est la prochaine génération à calculer, graine l'état du générateur à son début. */
+typedef struct {
+    uint64_t signature;
+    int n, pop_size, crossover, mutation;
+    double mutation_rate;
+    int gen, derniere_amelioration;
+    unsigned int graine;
+} GA_Checkpoint;
+
+static void ga_checkpoint_save(const Checkpoint_Options *cp, const GA_Checkpoint *ck,
+                               const GA_Individual *best, const GA_Individual *pop,
+                               const Tour_Cache *cache) {
+    Tour_Buffer b;
+    tour_buf_init(&b);
+    tour_buf_bytes(&b, ck, sizeof(*ck));
+    tour_buf_bytes(&b, &best->fitness, sizeof(double));
+    tour_buf_bytes(&b, best->perm, best->n * sizeof(int));
+    for (int i = 0; i < ck->pop_size; ++i) {
+        tour_buf_bytes(&b, &pop[i].fitness, sizeof(double));
+        tour_buf_bytes(&b, pop[i].perm, pop[i].n * sizeof(int));
+    }
+    /* DPX : le cache oriente la suite de la recherche (mêmes arêtes, autre sens de
+     * parcours), il fait partie de l'état */
+    if (cache) {
+        uint64_t taille = tour_cache_state_size(cache);
+        void *etat = malloc(taille);
+        if (etat) {
+            tour_cache_state_get(cache, etat);
+            tour_buf_bytes(&b, &taille, sizeof(taille));
+            tour_buf_bytes(&b, etat, taille);
+            free(etat);
+        } else {
+            b.erreur = 1;
+        }
+    }
+    if (!b.erreur)
+        checkpoint_write(cp->file, GA_CK_TYPE, b.data, b.len);
+    tour_buf_free(&b);
+}
+
+/* Relit une sauvegarde compatible avec ck (instance et paramètres) ; complète ck
+ * (génération, graine) et remplit best et pop. 0 si absente ou incompatible. */
+static int ga_checkpoint_load(const Checkpoint_Options *cp, GA_Checkpoint *ck,
+                              GA_Individual *best, GA_Individual *pop, Tour_Cache *cache) {
+    size_t len;
+    void *data = checkpoint_read(cp->file, GA_CK_TYPE, &len);
+    if (!data) return 0;
+
+    Checkpoint_Reader r = { data, len };
+    GA_Checkpoint lu;
+    int ok = checkpoint_get(&r, &lu, sizeof(lu)) && lu.signature == ck->signature && lu.n == ck->n &&
+             lu.pop_size == ck->pop_size && lu.crossover == ck->crossover && lu.mutation == ck->mutation &&
+             lu.mutation_rate == ck->mutation_rate;
+    ok = ok && checkpoint_get(&r, &best->fitness, sizeof(double)) &&
+         checkpoint_get(&r, best->perm, ck->n * sizeof(int));
+    for (int i = 0; ok && i < ck->pop_size; ++i)
+        ok = checkpoint_get(&r, &pop[i].fitness, sizeof(double)) &&
+             checkpoint_get(&r, pop[i].perm, ck->n * sizeof(int));
+    uint64_t taille;
+    if (ok && cache)
+        ok = checkpoint_get(&r, &taille, sizeof(taille)) && taille == r.reste &&
+             tour_cache_state_set(cache, r.p, r.reste);
+    else
+        ok = ok && r.reste == 0;
+    free(data);
+
+    if (!ok) {
+        fprintf(stderr, "[GA] %s : sauvegarde d'une autre instance ou d'autres paramètres, ignorée\n", cp->file);
+        return 0;
+    }
+    ck->gen = lu.gen;
+    ck->derniere_amelioration = lu.derniere_amelioration;
+    ck->graine = lu.graine;
+    return 1;
+}
+
+int* ga_tour(const TSP_Instance *inst, int pop_size, int generations, double mutation_rate,
+             int crossover, int mutation, unsigned int seed)
+{
+    return ga_tour_suivi(inst, pop_size, generations, mutation_rate, crossover, mutation, seed, NULL, NULL);
+}
+
+int* ga_tour_suivi(const TSP_Instance *inst, int pop_size, int generations, double mutation_rate,
+                   int crossover, int mutation, unsigned int seed, const GA_Suivi *suivi,
+                   Solve_Context *ctx)
 {
     if (!inst || inst->dimension <= 0 || !inst->dist)
         return NULL;
@@ -274,13 +552,44 @@ int* ga_tour(const TSP_Instance *inst, int pop_size, int generations, double mut
     int tsize = pop_size / 2;
     if (tsize < 1) tsize = 1;
 
-    srand((unsigned int)time(NULL));
+    ga_graine = seed ? seed : (unsigned int)time(NULL);
+
+    /* DPX : cache des optimums locaux + empreintes des enfants pour rejeter les doublons */
+    Tour_Cache *cache = NULL;
+    uint64_t *child_hash = NULL;
+    unsigned long long rejected = 0;
+    if (crossover == GA_CROSS_DPX) {
+        cache = tour_cache_create(n, GA_CACHE_SLOTS_PAR_INDIVIDU * pop_size, GA_CACHE_MAX_OCTETS);
+        child_hash = malloc(pop_size * sizeof(uint64_t));
+    }
+
+    /* GPX : deux parents identiques donnent le même enfant, doublons rejetés comme en DPX ;
+     * population initiale d'optimums locaux (le GPX échange les sous-chemins qu'ils
+     * ne partagent pas), construite comme en EAX puis passée au 2-opt */
+    GPX_Workspace *gpx = NULL;
+    EAX_Workspace *eax = NULL;
+    if (crossover == GA_CROSS_GPX) {
+        gpx = gpx_create(n);
+        if (!gpx) crossover = GA_CROSS_OX;
+        else {
+            child_hash = malloc(pop_size * sizeof(uint64_t));
+            eax = eax_create(inst);
+        }
+    }
+
+    /* EAX : espace de travail partagé par tous les croisements (OX si n trop petit) */
+    if (crossover == GA_CROSS_EAX) {
+        eax = eax_create(inst);
+        if (!eax) crossover = GA_CROSS_OX;
+    }
 
     /* Allocation population */
     GA_Individual *pop = malloc(pop_size * sizeof(GA_Individual));
     GA_Individual *childpop = malloc(pop_size * sizeof(GA_Individual));
 
-    if (!pop || !childpop) return NULL;
+    char *in_child = malloc(n);
+
+    if (!pop || !childpop || !in_child) return NULL;
 
     for (int i = 0; i < pop_size; ++i) {
         pop[i].n = n;
@@ -293,50 +602,148 @@ int* ga_tour(const TSP_Instance *inst, int pop_size, int generations, double mut
             return NULL;
     }
 
-    /* Population initiale */
-    for (int i = 0; i < pop_size; ++i) {
-        generate_random_perm(pop[i].perm, n);
-        pop[i].fitness = ga_tour_length(inst, pop[i].perm);
-    }
-
     /* Meilleur global */
     GA_Individual best;
     best.n = n;
     best.perm = malloc(n * sizeof(int));
 
-    int best_idx = 0;
-    for (int i = 1; i < pop_size; ++i)
-        if (pop[i].fitness < pop[best_idx].fitness)
-            best_idx = i;
+    /* Sauvegarde : reprise de l'état enregistré, sinon population initiale */
+    const Checkpoint_Options *cp = (suivi && suivi->checkpoint && suivi->checkpoint->file)
+                                 ? suivi->checkpoint : NULL;
+    GA_Checkpoint ck;
+    memset(&ck, 0, sizeof(ck));
+    ck.n = n;
+    ck.pop_size = pop_size;
+    ck.crossover = crossover;
+    ck.mutation = mutation;
+    ck.mutation_rate = mutation_rate;
+    int init_complete = 1;
+
+    if (cp) ck.signature = checkpoint_signature(inst);
+    if (cp && cp->reprise && ga_checkpoint_load(cp, &ck, &best, pop, cache)) {
+        ga_graine = ck.graine;
+        fprintf(stderr, "[GA] reprise de %s à la génération %d\n", cp->file, ck.gen);
+    } else {
+        /* Population initiale (arrêt : le reste de la population copie le premier individu) */
+        for (int i = 0; i < pop_size; ++i) {
+            if (i > 0 && solve_ctx_stop(ctx)) {
+                copy_individual(&pop[0], &pop[i]);
+                init_complete = 0;
+                continue;
+            }
+            if (eax)
+                eax_init_tour(eax, pop[i].perm);
+            else
+                generate_random_perm(pop[i].perm, n);
+            pop[i].fitness = ga_tour_length(inst, pop[i].perm);
+            if (gpx)
+                pop[i].fitness -= improve_2opt_gain(inst, pop[i].perm, ctx);
+        }
 
-    copy_individual(&pop[best_idx], &best);
+        int best_idx = 0;
+        for (int i = 1; i < pop_size; ++i)
+            if (pop[i].fitness < pop[best_idx].fitness)
+                best_idx = i;
+
+        copy_individual(&pop[best_idx], &best);
+    }
+    solve_ctx_report(ctx, best.fitness);
+
+    /* Trace de convergence (écrite par un thread dédié) et arrêt sur stagnation */
+    double t_debut = wall_seconds();
+    GA_Trace *trace = NULL;
+    uint64_t *trace_hash = NULL;
+    if (suivi && suivi->trace_file) {
+        trace_hash = malloc(pop_size * sizeof(uint64_t));
+        if (trace_hash) trace = ga_trace_open(suivi->trace_file, GA_TRACE_CAPACITE);
+        if (trace) trace_generation(trace, ck.gen, pop, pop_size, trace_hash, t_debut);
+    }
+    int stagnation = suivi ? suivi->stagnation : 0;
+    int derniere_amelioration = ck.derniere_amelioration;
+
+    /* exécution reprise déjà arrêtée sur stagnation : rien à recalculer */
+    if (stagnation > 0 && ck.gen > 0 && ck.gen - derniere_amelioration >= stagnation)
+        generations = ck.gen;
+    double periode = (cp && cp->periode > 0) ? cp->periode : CHECKPOINT_PERIODE_DEFAUT;
+    double prochaine_sauvegarde = t_debut + periode;
 
     /*
      *BOUCLE DES GÉNÉRATIONS
      */
-    for (int gen = 0; gen < generations; ++gen) {
+    double t_ga = stats_begin();
+    unsigned long long nb_gen = 0, nb_crossovers = 0;
+    for (int gen = ck.gen; gen < generations; ++gen) {
+
+        /* début de génération : ck décrit exactement l'état courant */
+        ck.gen = gen;
+        ck.derniere_amelioration = derniere_amelioration;
+        ck.graine = ga_graine;
+        if (cp && wall_seconds() >= prochaine_sauvegarde) {
+            ga_checkpoint_save(cp, &ck, &best, pop, cache);
+            prochaine_sauvegarde = wall_seconds() + periode;
+        }
 
-        if (stop_requested) break;
+        if (solve_ctx_stop(ctx)) break;
+        nb_gen++;
 
         /* Création des enfants */
+        int arret = 0;
         for (int i = 0; i < pop_size; ++i) {
 
-            if (stop_requested) break;
-
-            int p1 = tournament_select_index(pop, pop_size, tsize);
-            int p2 = tournament_select_index(pop, pop_size, tsize);
-            if (use_dpx){
-                dpx(inst, pop[p1].perm, pop[p2].perm, childpop[i].perm, n);
-                improve_2opt(inst, childpop[i].perm);
-                
-            } else {
-                ordered_crossover(pop[p1].perm, pop[p2].perm, childpop[i].perm, n);
+            if ((arret = solve_ctx_stop(ctx))) break;
+
+            for (int essai = 0; ; ++essai) {
+                int p1, p2;
+                if (crossover == GA_CROSS_EAX) {
+                    /* EAX : chaque individu est parent A une fois, B tiré au hasard ;
+                     * l'enfant (non muté) ne pouvant être pire que A, la diversité est préservée */
+                    p1 = i;
+                    p2 = rand_int(0, pop_size - 1);
+                } else {
+                    p1 = tournament_select_index(pop, pop_size, tsize);
+                    p2 = tournament_select_index(pop, pop_size, tsize);
+                }
+                /* Fitness suivie de façon incrémentale : croisement, 2-opt et mutation
+                 * retournent chacun la longueur ou sa variation */
+                double fit;
+                if (crossover == GA_CROSS_DPX){
+                    fit = dpx_local_search(inst, cache, pop[p1].perm, pop[p2].perm, childpop[i].perm, n, ctx);
+
+                } else if (crossover == GA_CROSS_EAX) {
+                    fit = eax_crossover(eax, pop[p1].perm, pop[p1].fitness, pop[p2].perm, childpop[i].perm);
+                } else if (crossover == GA_CROSS_GPX) {
+                    fit = gpx_crossover(gpx, inst, pop[p1].perm, pop[p1].fitness, pop[p2].perm,
+                                        pop[p2].fitness, childpop[i].perm);
+                    fit -= improve_2opt_gain(inst, childpop[i].perm, ctx);
+                } else {
+                    fit = ordered_crossover(inst, pop[p1].perm, pop[p2].perm, childpop[i].perm, n, in_child);
+                }
+                /* pas de mutation après EAX ni GPX : l'enfant pourrait devenir pire que ses parents */
+                if (crossover != GA_CROSS_EAX && crossover != GA_CROSS_GPX)
+                    fit += mutate(inst, childpop[i].perm, n, mutation_rate, mutation);
+                childpop[i].fitness = fit;
+                nb_crossovers++;
+
+                if (!child_hash) break;
+
+                /* Doublon d'un enfant de cette génération : on recommence (nombre d'essais borné) */
+                uint64_t h = tour_hash(childpop[i].perm, n);
+                int dup = 0;
+                for (int c = 0; c < i && !dup; ++c)
+                    dup = (child_hash[c] == h);
+                if (!dup || essai + 1 >= GA_MAX_REJETS) {
+                    child_hash[i] = h;
+                    break;
+                }
+                rejected++;
             }
-            swap_mutation(childpop[i].perm, n, mutation_rate);
-            childpop[i].fitness = ga_tour_length(inst, childpop[i].perm);
+#ifndef NDEBUG
+            check_fitness(inst, &childpop[i]);
+#endif
         }
 
-        if (stop_requested) break;
+        /* génération incomplète : on garde la population précédente */
+        if (arret) break;
 
         /* Trouver meilleur enfant */
         int best_child = 0;
@@ -345,8 +752,11 @@ int* ga_tour(const TSP_Instance *inst, int pop_size, int generations, double mut
                 best_child = i;
 
         /* Mise à jour du meilleur global */
-        if (childpop[best_child].fitness < best.fitness)
+        if (childpop[best_child].fitness < best.fitness) {
             copy_individual(&childpop[best_child], &best);
+            derniere_amelioration = gen + 1;
+            solve_ctx_report(ctx, best.fitness);
+        }
 
         /* remplace le pire individu */
         int worst = 0;
@@ -360,7 +770,27 @@ int* ga_tour(const TSP_Instance *inst, int pop_size, int generations, double mut
         GA_Individual *tmp = pop;
         pop = childpop;
         childpop = tmp;
+
+        ck.gen = gen + 1;
+        ck.derniere_amelioration = derniere_amelioration;
+        ck.graine = ga_graine;
+
+        if (trace) trace_generation(trace, gen + 1, pop, pop_size, trace_hash, t_debut);
+        if (stagnation > 0 && gen + 1 - derniere_amelioration >= stagnation) {
+            fprintf(stderr, "[GA] arrêt : %d générations sans amélioration (génération %d)\n",
+                    stagnation, gen + 1);
+            break;
+        }
     }
+    /* état final (génération interrompue : reprise à son début) ; pas de sauvegarde
+     * d'une population initiale incomplète */
+    if (cp && init_complete)
+        ga_checkpoint_save(cp, &ck, &best, pop, cache);
+    ga_trace_close(trace);
+    free(trace_hash);
+    stats_add(STAT_GA_GENERATIONS, nb_gen);
+    stats_add(STAT_CROSSOVERS, nb_crossovers);
+    stats_end(STAT_GA, t_ga);
 
     /* 
      * Construire la tournée finale retournée
@@ -378,6 +808,18 @@ int* ga_tour(const TSP_Instance *inst, int pop_size, int generations, double mut
     free(pop);
     free(childpop);
     free(best.perm);
+    free(in_child);
+    eax_free(eax);
+    gpx_free(gpx);
+
+    if (cache && stats_enabled) {
+        unsigned long long lookups, hits;
+        tour_cache_stats(cache, &lookups, &hits);
+        fprintf(stderr, "[GA] cache 2-opt : %llu/%llu succès (%.1f%%), doublons rejetés : %llu\n",
+                hits, lookups, lookups ? 100.0 * hits / lookups : 0.0, rejected);
+    }
+    tour_cache_free(cache);
+    free(child_hash);
 
     return tour;
 }
@@ -0,0 +1,294 @@
+/* algo_gpx.c
+ * Generalized Partition Crossover et fusion de plusieurs tournées.
+ * 1. arêtes de A absentes de B et de B absentes de A : union-find des extrémités ;
+ * 2. par composante : arêtes de A qui en sortent (forcément communes), longueur des
+ *    arêtes internes de A et de B ;
+ * 3. A (et B, les arêtes sortantes étant communes) traverse la composante en k chemins ;
+ *    si les chemins de B relient les mêmes paires de villes d'entrée que ceux de A
+ *    (toujours vrai pour k = 1), les remplacer garde un seul cycle : le plus court des
+ *    deux ensembles de chemins est retenu ; les autres composantes où B est plus court
+ *    sont essayées une à une (les plus rentables d'abord) et gardées si l'enfant reste
+ *    un seul cycle ;
+ * 4. l'enfant est reconstruit par ses listes d'adjacence (deux voisins par ville).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "algo_gpx.h"
+#include "algo_nn.h"
+#include "stats.h"
+
+#define GPX_PASSES_MAX 8        /* passes de gpx_merge au plus */
+#define GPX_ESSAIS_MAX 8        /* composantes incompatibles essayées par croisement */
+
+struct GPX_Workspace {
+    int n;
+    int *pos_a, *pos_b;         /* position de chaque ville dans A et dans B */
+    int *parent;                /* union-find ; -1 : ville sans arête propre */
+    int *sorties;               /* par racine : arêtes de A sortant ; puis 0 = B choisi, -1 = A */
+    int *bout_a, *bout_b;       /* ville d'entrée : autre extrémité de son chemin dans A, B */
+    double *int_a, *int_b;      /* par racine : longueur interne de A et de B */
+    int *adj;                   /* 2 voisins par ville dans l'enfant */
+    int *deg;
+};
+
+GPX_Workspace *gpx_create(int n) {
+    GPX_Workspace *ws = calloc(1, sizeof(GPX_Workspace));
+    if (!ws) return NULL;
+    ws->n = n;
+    ws->pos_a = malloc(n * sizeof(int));
+    ws->pos_b = malloc(n * sizeof(int));
+    ws->parent = malloc(n * sizeof(int));
+    ws->sorties = malloc(n * sizeof(int));
+    ws->bout_a = malloc(n * sizeof(int));
+    ws->bout_b = malloc(n * sizeof(int));
+    ws->int_a = malloc(n * sizeof(double));
+    ws->int_b = malloc(n * sizeof(double));
+    ws->adj = malloc(2 * (size_t)n * sizeof(int));
+    ws->deg = malloc(n * sizeof(int));
+    if (!ws->pos_a || !ws->pos_b || !ws->parent || !ws->sorties || !ws->bout_a || !ws->bout_b ||
+        !ws->int_a || !ws->int_b ||
+        !ws->adj || !ws->deg) {
+        gpx_free(ws);
+        return NULL;
+    }
+    return ws;
+}
+
+void gpx_free(GPX_Workspace *ws) {
+    if (!ws) return;
+    free(ws->pos_a);
+    free(ws->pos_b);
+    free(ws->parent);
+    free(ws->sorties);
+    free(ws->bout_a);
+    free(ws->bout_b);
+    free(ws->int_a);
+    free(ws->int_b);
+    free(ws->adj);
+    free(ws->deg);
+    free(ws);
+}
+
+static int trouver(int *parent, int v) {
+    while (parent[v] != v) {
+        parent[v] = parent[parent[v]];
+        v = parent[v];
+    }
+    return v;
+}
+
+static void unir(int *parent, int u, int v) {
+    if (parent[u] < 0) parent[u] = u;
+    if (parent[v] < 0) parent[v] = v;
+    u = trouver(parent, u);
+    v = trouver(parent, v);
+    if (u != v) parent[u] = v;
+}
+
+/* (u, v) est une arête de la tournée t (pos : positions dans t) */
+static inline int voisins(const int *t, const int *pos, int n, int u, int v) {
+    int i = pos[u];
+    return t[i == n - 1 ? 0 : i + 1] == v || t[i == 0 ? n - 1 : i - 1] == v;
+}
+
+static inline int composante(int *parent, int v) {
+    return parent[v] >= 0 ? trouver(parent, v) : -1;
+}
+
+/* Chemins de la tournée t à l'intérieur des composantes : bout[u] = autre extrémité du
+ * chemin qui commence ou finit en u (villes d'entrée seulement) */
+static void chemins(int *parent, const int *t, int n, int *bout) {
+    for (int i = 0; i < n; ++i) {
+        int c = composante(parent, t[i]);
+        if (c < 0 || composante(parent, t[i == 0 ? n - 1 : i - 1]) == c) continue;
+        // début d'un chemin : on avance tant qu'on reste dans la composante
+        int j = i;
+        while (composante(parent, t[j == n - 1 ? 0 : j + 1]) == c)
+            j = (j == n - 1) ? 0 : j + 1;
+        bout[t[i]] = t[j];
+        bout[t[j]] = t[i];
+    }
+}
+
+static inline void relier(GPX_Workspace *ws, int u, int v) {
+    ws->adj[2 * u + ws->deg[u]++] = v;
+    ws->adj[2 * v + ws->deg[v]++] = u;
+}
+
+/* Arêtes de l'enfant : A hors des composantes choisies (sorties = 0), B à l'intérieur */
+static void construire(GPX_Workspace *ws, const int *pa, const int *pb) {
+    int n = ws->n;
+    memset(ws->deg, 0, n * sizeof(int));
+    for (int i = 0; i < n; ++i) {
+        int u = pa[i], v = pa[i + 1 == n ? 0 : i + 1];
+        int cu = composante(ws->parent, u), cv = composante(ws->parent, v);
+        if (!(cu >= 0 && cu == cv && ws->sorties[cu] == 0))
+            relier(ws, u, v);
+        u = pb[i];
+        v = pb[i + 1 == n ? 0 : i + 1];
+        cu = composante(ws->parent, u);
+        cv = composante(ws->parent, v);
+        if (cu >= 0 && cu == cv && ws->sorties[cu] == 0)
+            relier(ws, u, v);
+    }
+}
+
+/* Parcours du cycle contenant depart (écrit dans child si non NULL) ; n si l'enfant
+ * est une seule tournée */
+static int parcourir(const GPX_Workspace *ws, int depart, int *child) {
+    int prec = -1, cur = depart, k = 0;
+    do {
+        if (child) child[k] = cur;
+        int suiv = (ws->adj[2 * cur] != prec) ? ws->adj[2 * cur] : ws->adj[2 * cur + 1];
+        prec = cur;
+        cur = suiv;
+        ++k;
+    } while (cur != depart && k < ws->n);
+    return k;
+}
+
+double gpx_crossover(GPX_Workspace *ws, const TSP_Instance *inst, const int *pa, double len_a,
+                     const int *pb, double len_b, int *child) {
+    int n = ws->n;
+    if (len_b < len_a) {
+        // A = meilleur parent : les composantes non échangeables viennent de lui
+        const int *t = pa;
+        pa = pb;
+        pb = t;
+        double l = len_a;
+        len_a = len_b;
+        len_b = l;
+    }
+    const double *d = inst->dist;
+
+    for (int i = 0; i < n; ++i) {
+        ws->pos_a[pa[i]] = i;
+        ws->pos_b[pb[i]] = i;
+        ws->parent[i] = -1;
+    }
+    // 1. composantes des arêtes propres à A ou à B
+    for (int i = 0; i < n; ++i) {
+        int u = pa[i], v = pa[i + 1 == n ? 0 : i + 1];
+        if (!voisins(pb, ws->pos_b, n, u, v)) unir(ws->parent, u, v);
+        u = pb[i];
+        v = pb[i + 1 == n ? 0 : i + 1];
+        if (!voisins(pa, ws->pos_a, n, u, v)) unir(ws->parent, u, v);
+    }
+    for (int v = 0; v < n; ++v)
+        if (ws->parent[v] >= 0) {
+            int r = trouver(ws->parent, v);
+            ws->sorties[r] = 0;
+            ws->int_a[r] = ws->int_b[r] = 0.0;
+        }
+
+    // 2. sorties et longueurs internes
+    for (int i = 0; i < n; ++i) {
+        int u = pa[i], v = pa[i + 1 == n ? 0 : i + 1];
+        int cu = ws->parent[u] >= 0 ? trouver(ws->parent, u) : -1;
+        int cv = ws->parent[v] >= 0 ? trouver(ws->parent, v) : -1;
+        if (cu >= 0 && cu == cv) {
+            ws->int_a[cu] += d[(size_t)u * n + v];
+        } else {
+            if (cu >= 0) ws->sorties[cu]++;
+            if (cv >= 0) ws->sorties[cv]++;
+        }
+        u = pb[i];
+        v = pb[i + 1 == n ? 0 : i + 1];
+        cu = ws->parent[u] >= 0 ? trouver(ws->parent, u) : -1;
+        if (cu >= 0 && ws->parent[v] >= 0 && cu == trouver(ws->parent, v))
+            ws->int_b[cu] += d[(size_t)u * n + v];
+    }
+
+    // 3. mêmes paires d'entrées dans A et B ; sinon la composante garde les chemins de A
+    chemins(ws->parent, pa, n, ws->bout_a);
+    chemins(ws->parent, pb, n, ws->bout_b);
+    for (int i = 0; i < n; ++i) {
+        int u = pa[i], v = pa[i + 1 == n ? 0 : i + 1];
+        int cu = composante(ws->parent, u), cv = composante(ws->parent, v);
+        if (cu == cv) continue;
+        if (cu >= 0 && ws->bout_a[u] != ws->bout_b[u]) ws->sorties[cu] = -1;
+        if (cv >= 0 && ws->bout_a[v] != ws->bout_b[v]) ws->sorties[cv] = -1;
+    }
+
+    // composantes compatibles où B est plus court : choisies (sorties = 0) ;
+    // les incompatibles plus courtes sont mises de côté (pos_b ne sert plus)
+    double len = len_a;
+    unsigned long long echanges = 0;
+    int *cand = ws->pos_b, nb_cand = 0;
+    for (int v = 0; v < n; ++v)
+        if (ws->parent[v] == v) {
+            int plus_court = ws->int_b[v] < ws->int_a[v];
+            if (plus_court && ws->sorties[v] >= 0) {
+                len -= ws->int_a[v] - ws->int_b[v];
+                ws->sorties[v] = 0;
+                echanges++;
+            } else {
+                if (plus_court) cand[nb_cand++] = v;
+                ws->sorties[v] = -1;
+            }
+        }
+
+    // essais des plus rentables : gardées si l'enfant reste une seule tournée
+    for (int e = 0; e < GPX_ESSAIS_MAX && nb_cand > 0; ++e) {
+        int m = 0;
+        for (int k = 1; k < nb_cand; ++k)
+            if (ws->int_a[cand[k]] - ws->int_b[cand[k]] > ws->int_a[cand[m]] - ws->int_b[cand[m]]) m = k;
+        int c = cand[m];
+        cand[m] = cand[--nb_cand];
+        ws->sorties[c] = 0;
+        construire(ws, pa, pb);
+        if (parcourir(ws, pa[0], NULL) == n) {
+            len -= ws->int_a[c] - ws->int_b[c];
+            echanges++;
+        } else {
+            ws->sorties[c] = -1;
+        }
+    }
+    stats_add(STAT_GPX_PARTITIONS, echanges);
+
+    // 4. enfant depuis la première ville de A (pa peut être child : départ lu avant)
+    construire(ws, pa, pb);
+    parcourir(ws, pa[0], child);
+    return len;
+}
+
+int *gpx_merge(const TSP_Instance *inst, const int *const *tours, int nb) {
+    int n = inst->dimension;
+    if (n <= 0 || nb <= 0 || !inst->dist) return NULL;
+
+    int best = 0;
+    double *lens = malloc(nb * sizeof(double));
+    int *tour = malloc(((size_t)n + 1) * sizeof(int));
+    GPX_Workspace *ws = (n >= 4 && nb > 1) ? gpx_create(n) : NULL;
+    if (!lens || !tour) {
+        free(lens);
+        free(tour);
+        gpx_free(ws);
+        return NULL;
+    }
+    for (int i = 0; i < nb; ++i) {
+        const int *t = tours[i];
+        lens[i] = 0.0;
+        for (int j = 0; j < n; ++j)
+            lens[i] += inst->dist[(size_t)t[j] * n + t[j + 1 == n ? 0 : j + 1]];
+        if (lens[i] < lens[best]) best = i;
+    }
+    memcpy(tour, tours[best], n * sizeof(int));
+    double len = lens[best];
+
+    // le meilleur croisé avec chaque autre ; une nouvelle passe tant que ça progresse
+    for (int passe = 0; ws && passe < GPX_PASSES_MAX; ++passe) {
+        double avant = len;
+        for (int i = 0; i < nb; ++i)
+            if (i != best || passe > 0)
+                len = gpx_crossover(ws, inst, tour, len, tours[i], lens[i], tour);
+        if (len >= avant - 1e-9) break;
+    }
+    tour[n] = tour[0];
+
+    free(lens);
+    gpx_free(ws);
+    return tour;
+}
@@ -0,0 +1,138 @@
+/* algo_hk.c
+ * Programmation dynamique de Held-Karp.
+ * C(S, j) = coût minimal d'un chemin partant de 0, visitant exactement S, finissant en j.
+ * - la ville 0 est implicite : S est un sous-ensemble de {1..n-1} codé sur n-1 bits ;
+ * - j appartient toujours à S : la table de j est indexée par S privé du bit j,
+ *   soit (n-1) * 2^(n-2) états au lieu de (n-1) * 2^(n-1) ;
+ * - coûts entiers 32 bits et pointeurs de parent sur 8 bits.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "algo_hk.h"
+#include "algo_nn.h"
+#include "algo_2opt.h"
+
+/* Retire le bit b de S en tassant les bits de poids supérieur */
+static inline uint32_t drop_bit(uint32_t S, int b) {
+    return (S & ((1u << b) - 1)) | ((S >> (b + 1)) << b);
+}
+
+/* Repli quand la DP est interrompue : NN + 2-opt */
+static int *fallback_tour(const TSP_Instance *inst, Solve_Context *ctx) {
+    int *tour = nn_tour(inst, ctx);
+    if (tour) improve_2opt(inst, tour, ctx);
+    return tour;
+}
+
+int* hk_tour(const TSP_Instance *inst, Solve_Context *ctx) {
+    int n = inst->dimension;
+    if (n <= 0 || !inst->dist) return NULL;
+    if (n <= 3) return nn_tour(inst, ctx);
+
+    if (n > HK_MAX_VILLES) {
+        fprintf(stderr, "Held-Karp : %d villes, maximum %d.\n", n, HK_MAX_VILLES);
+        return NULL;
+    }
+
+    // Distances entières ; la somme de n arêtes doit tenir sur 32 bits
+    uint32_t *d = malloc((size_t)n * n * sizeof(uint32_t));
+    if (!d) return NULL;
+    double dmax = 0.0;
+    for (size_t e = 0; e < (size_t)n * n; ++e) {
+        d[e] = (uint32_t)inst->dist[e];
+        if (inst->dist[e] > dmax) dmax = inst->dist[e];
+    }
+    if (dmax * n >= (double)UINT32_MAX) {
+        fprintf(stderr, "Held-Karp : distances trop grandes pour des coûts 32 bits.\n");
+        free(d);
+        return NULL;
+    }
+
+    int m = n - 1;                       /* villes 1..n-1 -> bits 0..m-1 */
+    size_t per_city = (size_t)1 << (m - 1);
+    uint32_t *cost = malloc((size_t)m * per_city * sizeof(uint32_t));
+    uint8_t *parent = malloc((size_t)m * per_city);
+    if (!cost || !parent) {
+        fprintf(stderr, "Held-Karp : mémoire insuffisante pour %d villes.\n", n);
+        free(d);
+        free(cost);
+        free(parent);
+        return NULL;
+    }
+
+#define C(j, s) cost[(size_t)(j) * per_city + (s)]
+#define P(j, s) parent[(size_t)(j) * per_city + (s)]
+
+    uint32_t full = (1u << m) - 1;
+
+    for (uint32_t S = 1; S <= full; ++S) {
+        if ((S & 0xFFFu) == 0 && solve_ctx_stop(ctx)) {
+            free(d);
+            free(cost);
+            free(parent);
+            return fallback_tour(inst, ctx);
+        }
+
+        for (int j = 0; j < m; ++j) {
+            if (!(S & (1u << j))) continue;
+            uint32_t R = S & ~(1u << j);          /* villes visitées avant j */
+            uint32_t sj = drop_bit(S, j);
+
+            if (R == 0) {
+                C(j, sj) = d[j + 1];              /* 0 -> j */
+                P(j, sj) = 0;
+                continue;
+            }
+
+            uint32_t best = UINT32_MAX;
+            int best_i = 0;
+            const uint32_t *dj = d + (size_t)(j + 1) * n;
+            for (uint32_t T = R; T; T &= T - 1) {
+                int i = __builtin_ctz(T);
+                uint32_t c = C(i, drop_bit(R, i)) + dj[i + 1];
+                if (c < best) {
+                    best = c;
+                    best_i = i + 1;
+                }
+            }
+            C(j, sj) = best;
+            P(j, sj) = (uint8_t)best_i;
+        }
+    }
+
+    // Fermeture du cycle
+    uint32_t best = UINT32_MAX;
+    int last = 0;
+    for (int j = 0; j < m; ++j) {
+        uint32_t c = C(j, drop_bit(full, j)) + d[(size_t)(j + 1) * n];
+        if (c < best) {
+            best = c;
+            last = j + 1;
+        }
+    }
+
+    // Reconstruction par les pointeurs de parent, de la fin vers le début
+    int *tour = malloc((n + 1) * sizeof(int));
+    if (tour) {
+        uint32_t S = full;
+        int city = last;
+        for (int pos = n - 1; pos >= 1; --pos) {
+            tour[pos] = city;
+            int prev = P(city - 1, drop_bit(S, city - 1));
+            S &= ~(1u << (city - 1));
+            city = prev;
+        }
+        tour[0] = 0;
+        tour[n] = 0;
+    }
+
+#undef C
+#undef P
+
+    free(d);
+    free(cost);
+    free(parent);
+    return tour;
+}
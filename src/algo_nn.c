@@ -6,22 +6,43 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <float.h>
+#include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
 #include "algo_nn.h"
+#include "algo_2opt.h"
+#include "algo_gpx.h"
+#include "distance.h"
+#include "stats.h"
 #include "tsp_parser.h"
 
-int* nn_tour(const TSP_Instance *inst) {
+/* Contrôle de l'arrêt toutes les NN_PERIODE villes placées (chaque pas coûte O(n)) */
+#define NN_PERIODE 16
+
+int* nn_tour(const TSP_Instance *inst, Solve_Context *ctx) {
     int n = inst->dimension;
     if (n <= 0 || !inst->dist) return NULL;
 
     int *tour = malloc((n + 1) * sizeof(int));
     int *visite = calloc(n, sizeof(int));
-    if (!tour || !visite) return NULL;
+    if (!tour || !visite) {
+        free(tour);
+        free(visite);
+        return NULL;
+    }
+    double t0 = stats_begin();
 
     int courant = 0;
     tour[0] = 0;
     visite[0] = 1;
 
     for (int k = 1; k < n; ++k) {
+        if (k % NN_PERIODE == 0 && solve_ctx_stop(ctx)) {
+            // tournée valide malgré l'arrêt : villes restantes dans l'ordre
+            for (int j = 0; j < n; ++j)
+                if (!visite[j]) tour[k++] = j;
+            break;
+        }
         double min = DBL_MAX;
         int prochain = -1;
         for (int j = 0; j < n; ++j) {
@@ -37,14 +58,251 @@ int* nn_tour(const TSP_Instance *inst) {
 
     tour[n] = 0;  // retour au départ
 
+    stats_add(STAT_DIST_LOOKUPS, (unsigned long long)n * (n - 1) / 2);
+    stats_end(STAT_CONSTRUCT, t0);
     free(visite);
+    if (solve_ctx_wants_progress(ctx))
+        solve_ctx_report(ctx, tour_length(inst, tour));
     return tour;
 }
 
 double tour_length(const TSP_Instance *inst, int *tour) {
     double total = 0;
     int n = inst->dimension;
+    if (!inst->dist) {
+        // instance sans matrice : distances recalculées depuis les coordonnées
+        for (int i = 0; i < n; ++i)
+            total += distance_ij(inst, tour[i], tour[i + 1]);
+        return total;
+    }
     for (int i = 0; i < n; ++i)
         total += inst->dist[tour[i] * n + tour[i + 1]];
     return total;
 }
+
+/* ---------- NN multi-départs ---------- */
+
+typedef struct {
+    const TSP_Instance *inst;
+    Solve_Context *ctx;
+    int nb_departs;
+    int k;                      /* nombre de tournées conservées */
+    atomic_int next;            /* prochain indice de départ / de tournée à traiter */
+    _Atomic double seuil;       /* longueur de la k-ième meilleure, DBL_MAX tant qu'incomplet */
+    pthread_mutex_t lock;       /* protège le classement ci-dessous */
+    int nb_gardes;
+    double *best_len;           /* classement croissant (longueur, départ) */
+    int *best_depart;
+    int *best_tours;            /* k tournées de n + 1 villes */
+} NN_Shared;
+
+typedef struct {
+    NN_Shared *sh;
+    pthread_t thread;
+    int *tour;
+    int *reste;
+    int phase;                  /* 0 : construction, 1 : 2-opt */
+    unsigned long long acces;   /* accès à la matrice (--stats) */
+} NN_Worker;
+
+static int depart_of(const NN_Shared *sh, int idx) {
+    int n = sh->inst->dimension;
+    return (int)((long long)idx * n / sh->nb_departs);
+}
+
+/* Construit la tournée NN depuis depart ; -1 si abandonnée en cours de route.
+ * reste[0..m-1] contient les villes non visitées : chaque pas ne parcourt qu'elles. */
+static double nn_from(NN_Shared *sh, int depart, int *tour, int *reste, unsigned long long *acces) {
+    const TSP_Instance *inst = sh->inst;
+    int n = inst->dimension;
+
+    int m = 0;
+    for (int j = 0; j < n; ++j)
+        if (j != depart) reste[m++] = j;
+
+    int courant = depart;
+    tour[0] = depart;
+    double len = 0.0;
+
+    for (int k = 1; k < n; ++k) {
+        if (k % NN_PERIODE == 0 && solve_ctx_stop(sh->ctx))
+            return -1.0;
+        const double *ligne = inst->dist + (size_t)courant * n;
+        int best = 0, prochain = reste[0];
+        double d_best = ligne[prochain];
+        for (int r = 1; r < m; ++r) {
+            // à distance égale, plus petit indice d'abord (comme nn_tour)
+            int v = reste[r];
+            if (ligne[v] < d_best || (ligne[v] == d_best && v < prochain)) {
+                best = r;
+                prochain = v;
+                d_best = ligne[v];
+            }
+        }
+        *acces += m;
+        reste[best] = reste[--m];
+
+        len += ligne[prochain];
+        // Déjà plus longue que la k-ième meilleure : inutile de continuer
+        if (len > atomic_load_explicit(&sh->seuil, memory_order_relaxed))
+            return -1.0;
+        tour[k] = prochain;
+        courant = prochain;
+    }
+
+    tour[n] = depart;
+    len += inst->dist[courant * n + depart];
+    return len;
+}
+
+/* Insère la tournée dans le classement si elle y a sa place */
+static void nn_offer(NN_Shared *sh, int depart, double len, const int *tour) {
+    int n = sh->inst->dimension;
+    pthread_mutex_lock(&sh->lock);
+
+    // Ordre (longueur, départ) : même résultat quel que soit le nombre de threads
+    int pos = sh->nb_gardes;
+    while (pos > 0 && (len < sh->best_len[pos - 1] ||
+                       (len == sh->best_len[pos - 1] && depart < sh->best_depart[pos - 1])))
+        pos--;
+
+    if (pos < sh->k) {
+        int last = (sh->nb_gardes < sh->k) ? sh->nb_gardes : sh->k - 1;
+        for (int i = last; i > pos; --i) {
+            sh->best_len[i] = sh->best_len[i - 1];
+            sh->best_depart[i] = sh->best_depart[i - 1];
+            memcpy(sh->best_tours + (size_t)i * (n + 1), sh->best_tours + (size_t)(i - 1) * (n + 1),
+                   (n + 1) * sizeof(int));
+        }
+        sh->best_len[pos] = len;
+        sh->best_depart[pos] = depart;
+        memcpy(sh->best_tours + (size_t)pos * (n + 1), tour, (n + 1) * sizeof(int));
+        if (sh->nb_gardes < sh->k) sh->nb_gardes++;
+        if (sh->nb_gardes == sh->k)
+            atomic_store(&sh->seuil, sh->best_len[sh->k - 1]);
+        if (pos == 0)
+            solve_ctx_report(sh->ctx, len);
+    }
+
+    pthread_mutex_unlock(&sh->lock);
+}
+
+static void *nn_worker_main(void *arg) {
+    NN_Worker *w = arg;
+    NN_Shared *sh = w->sh;
+    int n = sh->inst->dimension;
+
+    if (w->phase == 0) {
+        int idx;
+        while (!solve_ctx_stop(sh->ctx) && (idx = atomic_fetch_add(&sh->next, 1)) < sh->nb_departs) {
+            int depart = depart_of(sh, idx);
+            double len = nn_from(sh, depart, w->tour, w->reste, &w->acces);
+            if (len >= 0)
+                nn_offer(sh, depart, len, w->tour);
+        }
+    } else {
+        int idx;
+        while (!solve_ctx_stop(sh->ctx) && (idx = atomic_fetch_add(&sh->next, 1)) < sh->nb_gardes) {
+            int *t = sh->best_tours + (size_t)idx * (n + 1);
+            sh->best_len[idx] -= improve_2opt_gain(sh->inst, t, sh->ctx);
+            solve_ctx_report(sh->ctx, sh->best_len[idx]);
+        }
+    }
+    return NULL;
+}
+
+static void nn_run_phase(NN_Worker *workers, int nb_threads, int phase) {
+    NN_Shared *sh = workers[0].sh;
+    atomic_store(&sh->next, 0);
+
+    int started = 0;
+    for (int t = 0; t < nb_threads; ++t) {
+        workers[t].phase = phase;
+        if (nb_threads > 1 && pthread_create(&workers[t].thread, NULL, nn_worker_main, &workers[t]) == 0)
+            started++;
+        else
+            break;
+    }
+    // Séquentiel, ou aucun thread créé : le thread appelant termine le travail
+    if (started < nb_threads) {
+        workers[started].phase = phase;
+        nn_worker_main(&workers[started]);
+    }
+    for (int t = 0; t < started; ++t)
+        pthread_join(workers[t].thread, NULL);
+}
+
+int* nn_multistart(const TSP_Instance *inst, int nb_departs, int nb_threads, int top_k, Solve_Context *ctx) {
+    int n = inst->dimension;
+    if (n <= 0 || !inst->dist) return NULL;
+
+    if (nb_departs <= 0 || nb_departs > n) nb_departs = n;
+    int k = (top_k > 0) ? top_k : 1;
+    if (k > nb_departs) k = nb_departs;
+    if (nb_threads < 1) nb_threads = 1;
+    if (nb_threads > nb_departs) nb_threads = nb_departs;
+
+    NN_Shared sh;
+    sh.inst = inst;
+    sh.ctx = ctx;
+    sh.nb_departs = nb_departs;
+    sh.k = k;
+    sh.nb_gardes = 0;
+    atomic_init(&sh.next, 0);
+    atomic_init(&sh.seuil, DBL_MAX);
+    sh.best_len = malloc(k * sizeof(double));
+    sh.best_depart = malloc(k * sizeof(int));
+    sh.best_tours = malloc((size_t)k * (n + 1) * sizeof(int));
+
+    NN_Worker *workers = calloc(nb_threads, sizeof(NN_Worker));
+    int ok = (sh.best_len && sh.best_depart && sh.best_tours && workers);
+    for (int t = 0; ok && t < nb_threads; ++t) {
+        workers[t].sh = &sh;
+        workers[t].tour = malloc((n + 1) * sizeof(int));
+        workers[t].reste = malloc(n * sizeof(int));
+        ok = (workers[t].tour && workers[t].reste);
+    }
+
+    int *tour = NULL;
+    if (ok) {
+        pthread_mutex_init(&sh.lock, NULL);
+        double t0 = stats_begin();
+        nn_run_phase(workers, nb_threads, 0);
+        stats_end(STAT_CONSTRUCT, t0);
+        if (top_k > 0 && sh.nb_gardes > 0)
+            nn_run_phase(workers, nb_threads < sh.nb_gardes ? nb_threads : sh.nb_gardes, 1);
+        pthread_mutex_destroy(&sh.lock);
+
+        int best = -1;
+        for (int i = 0; i < sh.nb_gardes; ++i)
+            if (best < 0 || sh.best_len[i] < sh.best_len[best])
+                best = i;
+        if (top_k > 1 && sh.nb_gardes > 1) {
+            // optimums locaux fusionnés par GPX plutôt que le seul meilleur
+            const int **tours = malloc(sh.nb_gardes * sizeof(int *));
+            for (int i = 0; tours && i < sh.nb_gardes; ++i)
+                tours[i] = sh.best_tours + (size_t)i * (n + 1);
+            if (tours) tour = gpx_merge(inst, tours, sh.nb_gardes);
+            free(tours);
+            if (tour) solve_ctx_report(ctx, tour_length(inst, tour));
+        }
+        if (!tour && best >= 0) {
+            tour = malloc((n + 1) * sizeof(int));
+            if (tour)
+                memcpy(tour, sh.best_tours + (size_t)best * (n + 1), (n + 1) * sizeof(int));
+        }
+    }
+
+    for (int t = 0; workers && t < nb_threads; ++t) {
+        stats_add(STAT_DIST_LOOKUPS, workers[t].acces);
+        free(workers[t].tour);
+        free(workers[t].reste);
+    }
+    free(workers);
+    free(sh.best_len);
+    free(sh.best_depart);
+    free(sh.best_tours);
+
+    // Interrompu avant la première tournée complète : départ unique classique
+    return tour ? tour : nn_tour(inst, ctx);
+}
@@ -1,44 +1,227 @@
 /* algo_rw.c
  * Implémente la marche aléatoire (Random Walk) : génère des tournées au hasard.
- * Paramètres : nombre d'itérations, seed ; garde la meilleure trouvée.
+ * Paramètres : nombre de tirages et/ou budget de temps, threads ; garde la meilleure trouvée.
  * Entrée : Instance ; Sortie : meilleure Tour trouvée après N tirages.
  */
 
+#include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
 #include <time.h>
+#include <pthread.h>
+#include <stdatomic.h>
 #include "algo_rw.h"
+#include "algo_2opt.h"
+#include "algo_gpx.h"
+#include "thread_pool.h"
+#include "stats.h"
 #include "tsp_parser.h"
+#include "rng.h"
 
- #include <stdlib.h>
-#include <time.h>
-#include "algo_rw.h"
+#define RW_LOT 256              /* tirages réservés d'un coup par un thread */
 
-int* rw_tour(const TSP_Instance *inst) {
-    srand(time(NULL));
+/* Mélange de Fisher-Yates fusionné avec le calcul de la longueur : chaque position
+ * fixée ajoute son arête. Le tirage est abandonné (retour -1) dès que la longueur
+ * partielle dépasse seuil ; le mélange suivant repart de l'ordre courant, ce qui
+ * reste uniforme. */
+static double shuffle_measure(const TSP_Instance *inst, int *tour, uint64_t *rng, double seuil,
+                              unsigned long long *acces) {
+    int n = inst->dimension;
+    const double *d = inst->dist;
+    double len = 0.0;
+
+    for (int i = n - 1; i > 0; --i) {
+        int j = splitmix64_below(rng, i + 1);
+        int t = tour[i]; tour[i] = tour[j]; tour[j] = t;
+        if (i + 1 < n) {
+            len += d[tour[i] * n + tour[i + 1]];
+            if (len > seuil) {
+                *acces += n - i;
+                return -1.0;
+            }
+        }
+    }
+    *acces += n;
+    if (n > 1)
+        len += d[tour[0] * n + tour[1]];
+    len += d[tour[n - 1] * n + tour[0]];
+    tour[n] = tour[0];
+    return len;
+}
 
+int* rw_tour(const TSP_Instance *inst) {
     int n = inst->dimension;
     if (n <= 0 || !inst->dist) return NULL;
 
     int *tour = malloc((n + 1) * sizeof(int));  // alloue une case de plus
-    int *visite = malloc(n * sizeof(int));
-    if (!tour || !visite) return NULL;
+    if (!tour) return NULL;
 
     for (int i = 0; i < n; i++)
-        visite[i] = i;
+        tour[i] = i;
+
+    uint64_t rng = (uint64_t)time(NULL);
+    unsigned long long acces = 0;
+    shuffle_measure(inst, tour, &rng, 1e300, &acces);
+    stats_add(STAT_DIST_LOOKUPS, acces);   // on boucle le tour (tour[n] = tour[0])
+    return tour;
+}
+
+/* ---------- Moteur d'échantillonnage parallèle ---------- */
+
+typedef struct {
+    const TSP_Instance *inst;
+    Solve_Context *ctx;
+    long long nb_samples;       /* <= 0 : illimité */
+    double deadline;            /* <= 0 : pas de limite */
+    int with_2opt;
+    atomic_llong next;          /* tirages déjà réservés */
+    atomic_int fini;            /* budget de temps épuisé */
+} RW_Shared;
+
+typedef struct {
+    RW_Shared *sh;
+    pthread_t thread;
+    uint64_t rng;
+    int *tour;
+    int *best;
+    double best_len;
+    GPX_Workspace *gpx;         /* rw2opt : chaque optimum local est fusionné dans best */
+    long long done;
+    unsigned long long acces;   /* accès à la matrice (--stats) */
+} RW_Worker;
 
-    int remaining = n;
+static void *rw_worker_main(void *arg) {
+    RW_Worker *w = arg;
+    RW_Shared *sh = w->sh;
+    int n = sh->inst->dimension;
 
-    for (int i = 0; i < n; i++) {
-        int pick = rand() % remaining;
-        tour[i] = visite[pick];
+    while (!solve_ctx_stop(sh->ctx) && !atomic_load_explicit(&sh->fini, memory_order_relaxed)) {
+        long long debut = atomic_fetch_add(&sh->next, RW_LOT);
+        long long lot = RW_LOT;
+        if (sh->nb_samples > 0) {
+            if (debut >= sh->nb_samples) break;
+            if (debut + lot > sh->nb_samples) lot = sh->nb_samples - debut;
+        }
 
-        for (int j = pick; j < remaining - 1; j++)
-            visite[j] = visite[j + 1];
+        for (long long s = 0; s < lot; ++s) {
+            double len;
+            if (sh->with_2opt) {
+                // le 2-opt peut sauver n'importe quel tirage : pas d'abandon
+                len = shuffle_measure(sh->inst, w->tour, &w->rng, 1e300, &w->acces);
+                len -= improve_2opt_gain(sh->inst, w->tour, sh->ctx);
+            } else {
+                len = shuffle_measure(sh->inst, w->tour, &w->rng, w->best_len, &w->acces);
+            }
+            w->done++;
+            if (w->gpx && w->done > 1) {
+                // fusion GPX : jamais plus long que le meilleur ni que le nouveau tirage
+                len = gpx_crossover(w->gpx, sh->inst, w->best, w->best_len, w->tour, len, w->tour);
+                w->tour[n] = w->tour[0];
+            }
+            if (len >= 0 && len < w->best_len) {
+                w->best_len = len;
+                memcpy(w->best, w->tour, (n + 1) * sizeof(int));
+                solve_ctx_report(sh->ctx, len);
+            }
+            // un 2-opt peut être long : budget et contexte vérifiés à chaque tirage
+            if (sh->with_2opt && (solve_ctx_stop(sh->ctx) || (sh->deadline > 0 && wall_seconds() >= sh->deadline)))
+                break;
+        }
 
-        remaining--;
+        if (sh->deadline > 0 && wall_seconds() >= sh->deadline)
+            atomic_store(&sh->fini, 1);
     }
+    return NULL;
+}
 
-    tour[n] = tour[0];  // on boucle le tour (retour à la ville de départ)
-    free(visite);
-    return tour;
+int* rw_sample(const TSP_Instance *inst, long long nb_samples, double time_budget,
+               int nb_threads, int with_2opt, unsigned long long seed, Solve_Context *ctx) {
+    int n = inst->dimension;
+    if (n <= 0 || !inst->dist) return NULL;
+
+    if (nb_samples <= 0 && time_budget <= 0) nb_samples = 1;
+    if (nb_threads < 1) nb_threads = 1;
+    if (nb_samples > 0 && nb_threads > (nb_samples + RW_LOT - 1) / RW_LOT)
+        nb_threads = (int)((nb_samples + RW_LOT - 1) / RW_LOT);
+
+    double t0 = wall_seconds();
+    RW_Shared sh;
+    sh.inst = inst;
+    sh.ctx = ctx;
+    sh.nb_samples = nb_samples;
+    sh.deadline = (time_budget > 0) ? t0 + time_budget : 0;
+    sh.with_2opt = with_2opt;
+    atomic_init(&sh.next, 0);
+    atomic_init(&sh.fini, 0);
+
+    RW_Worker *workers = calloc(nb_threads, sizeof(RW_Worker));
+    int ok = (workers != NULL);
+    uint64_t graine = seed ? seed : (uint64_t)time(NULL);
+    for (int t = 0; ok && t < nb_threads; ++t) {
+        RW_Worker *w = &workers[t];
+        w->sh = &sh;
+        // graines dérivées par splitmix64 : flux décorrélés
+        w->rng = graine + (uint64_t)t * SPLITMIX64_GAMMA;
+        splitmix64(&w->rng);
+        w->best_len = 1e300;
+        w->tour = malloc((n + 1) * sizeof(int));
+        w->best = malloc((n + 1) * sizeof(int));
+        ok = (w->tour && w->best);
+        if (ok && with_2opt && n >= 4)
+            w->gpx = gpx_create(n);
+        for (int i = 0; ok && i < n; ++i)
+            w->tour[i] = i;
+    }
+
+    int *tour = NULL;
+    if (ok) {
+        int started = 0;
+        for (int t = 1; t < nb_threads; ++t) {
+            if (pthread_create(&workers[t].thread, NULL, rw_worker_main, &workers[t]) != 0)
+                break;
+            started++;
+        }
+        // le thread appelant travaille aussi
+        rw_worker_main(&workers[0]);
+        for (int t = 1; t <= started; ++t)
+            pthread_join(workers[t].thread, NULL);
+
+        // Fusion des meilleures tournées locales
+        int best = -1;
+        long long total = 0;
+        for (int t = 0; t < nb_threads; ++t) {
+            total += workers[t].done;
+            stats_add(STAT_DIST_LOOKUPS, workers[t].acces);
+            if (workers[t].done > 0 && (best < 0 || workers[t].best_len < workers[best].best_len))
+                best = t;
+        }
+        if (with_2opt && best >= 0 && nb_threads > 1) {
+            // meilleures tournées des threads fusionnées par GPX
+            const int **bests = malloc(nb_threads * sizeof(int *));
+            int nb = 0;
+            for (int t = 0; bests && t < nb_threads; ++t)
+                if (workers[t].done > 0) bests[nb++] = workers[t].best;
+            if (bests) tour = gpx_merge(inst, bests, nb);
+            free(bests);
+        }
+        if (!tour && best >= 0 && (tour = malloc((n + 1) * sizeof(int))))
+            memcpy(tour, workers[best].best, (n + 1) * sizeof(int));
+
+        // tirages seuls : construction ; avec 2-opt, le temps est compté dans improve
+        if (!with_2opt) stats_end(STAT_CONSTRUCT, t0);
+        if (stats_enabled) {
+            double elapsed = wall_seconds() - t0;
+            fprintf(stderr, "[RW] %lld tirages, %.0f tirages/s\n",
+                    total, elapsed > 0 ? total / elapsed : 0.0);
+        }
+    }
+
+    for (int t = 0; workers && t < nb_threads; ++t) {
+        free(workers[t].tour);
+        free(workers[t].best);
+        gpx_free(workers[t].gpx);
+    }
+    free(workers);
+    return tour ? tour : rw_tour(inst);
 }
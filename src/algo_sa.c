@@ -0,0 +1,425 @@
+/* algo_sa.c
+ * Recuit simulé (simulated annealing) pour le TSP.
+ * - tournée en tableau + position de chaque ville : successeur/prédécesseur en O(1) ;
+ * - mouvements tirés vers les voisins candidats : 2-opt (a, c) et Or-opt (segment de
+ *   1 à 3 villes réinséré à côté d'un voisin de sa première ville, dans les deux sens) ;
+ * - variation de longueur en O(1) ; un mouvement accepté est appliqué par inversions
+ *   de chemins (une Or-opt = 2 ou 3 inversions), chacune du côté le plus court du cycle ;
+ * - acceptation : u < exp(-delta / T), exponentielle approchée (Schraudolph) ;
+ * - température : T0 * (Tfin / T0)^(temps écoulé / budget), relue tous les SA_LOT mouvements.
+ * Parallel tempering : une réplique par thread, températures T(t) * SA_PT_RATIO^rang ;
+ * toutes les SA_PT_EPOQUE lots, les threads se synchronisent et les répliques voisines
+ * sur l'échelle échangent leurs températures selon le critère de Metropolis.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <pthread.h>
+#include "algo_sa.h"
+#include "algo_nn.h"
+#include "neighbors.h"
+#include "thread_pool.h"
+#include "stats.h"
+#include "rng.h"
+
+#define SA_K            10      /* voisins candidats par ville */
+#define SA_LOT          1024    /* mouvements entre deux lectures de l'horloge */
+#define SA_ECHANTILLON  1000    /* mouvements tirés pour estimer la température initiale */
+#define SA_ACCEPT_INIT  0.1     /* acceptation initiale d'une dégradation moyenne */
+#define SA_REFROIDISSEMENT 1e-3 /* Tfin / T0 */
+#define SA_PT_RATIO     1.3     /* rapport de températures entre répliques voisines */
+#define SA_PT_EPOQUE    16      /* lots entre deux tentatives d'échange */
+
+/* exp(x) pour x <= 0, à quelques % près : x / ln 2 placé directement dans
+ * l'exposant d'un double (Schraudolph, 1999) */
+static inline double exp_rapide(double x) {
+    if (x < -700.0) return 0.0;
+    union { double d; int64_t i; } u;
+    u.i = (int64_t)(6497320848556798.0 * x) + 4606921280493453312LL;
+    return u.d;
+}
+
+/* Critère de Metropolis ; au-delà de 20 T la probabilité (< 2e-9) est arrondie à 0 */
+static inline int accepter(double delta, double T, uint64_t *rng) {
+    if (delta <= 0.0) return 1;
+    double x = -delta / T;
+    return x > -20.0 && splitmix64_uniform(rng) < exp_rapide(x);
+}
+
+typedef struct {
+    const TSP_Instance *inst;
+    const int *cand;            /* n * k voisins candidats */
+    int k;
+    int n;
+    int *tour;                  /* n villes */
+    int *pos;                   /* pos[ville] = indice dans tour */
+    double len;                 /* longueur courante, tenue incrémentalement */
+    int *best;
+    double best_len;
+    uint64_t rng;
+    unsigned long long essais, acceptes;
+} SA_Replique;
+
+static inline double D(const SA_Replique *r, int u, int v) {
+    return r->inst->dist[(size_t)u * r->n + v];
+}
+
+static inline int succ(const SA_Replique *r, int v) {
+    int p = r->pos[v] + 1;
+    return r->tour[p == r->n ? 0 : p];
+}
+
+static inline int pred(const SA_Replique *r, int v) {
+    int p = r->pos[v];
+    return r->tour[p == 0 ? r->n - 1 : p - 1];
+}
+
+/* Inverse le chemin u -> ... -> v (sens des successeurs) : même cycle que l'inversion
+ * du chemin complémentaire, on inverse donc le plus court des deux */
+static void reverse_path(SA_Replique *r, int u, int v) {
+    int n = r->n;
+    int i = r->pos[u], j = r->pos[v];
+    int len = j - i;
+    if (len < 0) len += n;
+    len += 1;
+    if (2 * len > n) {
+        int t = i;
+        i = (j + 1 == n) ? 0 : j + 1;
+        j = (t == 0) ? n - 1 : t - 1;
+        len = n - len;
+    }
+    for (int s = 0; s < len / 2; ++s) {
+        int a = r->tour[i], b = r->tour[j];
+        r->tour[i] = b;
+        r->pos[b] = i;
+        r->tour[j] = a;
+        r->pos[a] = j;
+        i = (i + 1 == n) ? 0 : i + 1;
+        j = (j == 0) ? n - 1 : j - 1;
+    }
+}
+
+/* Mouvement tiré au hasard ; *delta reçoit la variation, la fonction retourne un code
+ * décrivant l'application (0 : mouvement impossible). Les villes concernées sont dans m[]. */
+enum { SA_AUCUN, SA_2OPT_SUCC, SA_2OPT_PRED, SA_OR_DIRECT, SA_OR_INVERSE };
+
+static int tirer(SA_Replique *r, double *delta, int m[6]) {
+    int a = splitmix64_below(&r->rng, r->n);
+    int c = r->cand[(size_t)a * r->k + splitmix64_below(&r->rng, r->k)];
+    uint64_t h = splitmix64(&r->rng);
+
+    if (h & 1) {
+        // 2-opt : a et c deviennent voisins
+        if (h & 2) {
+            int b = succ(r, a), d = succ(r, c);
+            if (c == b || d == a) return SA_AUCUN;
+            *delta = D(r, a, c) + D(r, b, d) - D(r, a, b) - D(r, c, d);
+            m[0] = b; m[1] = c;
+            return SA_2OPT_SUCC;
+        }
+        int b = pred(r, a), d = pred(r, c);
+        if (c == b || d == a) return SA_AUCUN;
+        *delta = D(r, a, c) + D(r, b, d) - D(r, b, a) - D(r, d, c);
+        m[0] = a; m[1] = d;
+        return SA_2OPT_PRED;
+    }
+
+    // Or-opt : segment s1..s2 (L villes à partir de a) inséré entre c et son successeur
+    int L = 1 + (int)((h >> 2) % 3);
+    if (r->n < L + 3) return SA_AUCUN;
+    int s1 = a, s2 = a;
+    for (int i = 1; i < L; ++i) {
+        s2 = succ(r, s2);
+        if (s2 == c) return SA_AUCUN;
+    }
+    if (c == s1) return SA_AUCUN;
+    int p = pred(r, s1), nx = succ(r, s2), e = succ(r, c);
+    if (c == p) return SA_AUCUN;
+
+    double retrait = D(r, p, nx) - D(r, p, s1) - D(r, s2, nx) - D(r, c, e);
+    double direct = D(r, c, s1) + D(r, s2, e);
+    double inverse = D(r, c, s2) + D(r, s1, e);
+    m[0] = s1; m[1] = s2; m[2] = p; m[3] = nx; m[4] = c; m[5] = e;
+    if (direct <= inverse) {
+        *delta = retrait + direct;
+        return SA_OR_DIRECT;
+    }
+    *delta = retrait + inverse;
+    return SA_OR_INVERSE;
+}
+
+static void appliquer(SA_Replique *r, int code, const int m[6]) {
+    switch (code) {
+    case SA_2OPT_SUCC:
+    case SA_2OPT_PRED:
+        reverse_path(r, m[0], m[1]);
+        break;
+    case SA_OR_DIRECT:
+    case SA_OR_INVERSE:
+        // p S nx X c e  ->  p c X^r nx S^r e  ->  p nx X c S^r e  (->  p nx X c S e).
+        // reverse_path peut inverser le complément, donc le sens de parcours : le sens
+        // des inversions suivantes est relu sur la tournée
+        reverse_path(r, m[0], m[4]);
+        if (succ(r, m[2]) == m[4]) reverse_path(r, m[4], m[3]);
+        else reverse_path(r, m[3], m[4]);
+        if (code == SA_OR_DIRECT) {
+            if (succ(r, m[4]) == m[1]) reverse_path(r, m[1], m[0]);
+            else reverse_path(r, m[0], m[1]);
+        }
+        break;
+    }
+}
+
+/* nb mouvements à la température T ; la meilleure tournée est relevée en fin de lot */
+static void recuire(SA_Replique *r, double T, int nb) {
+    int m[6];
+    double delta;
+    for (int i = 0; i < nb; ++i) {
+        int code = tirer(r, &delta, m);
+        if (code == SA_AUCUN) continue;
+        r->essais++;
+        if (accepter(delta, T, &r->rng)) {
+            appliquer(r, code, m);
+            r->len += delta;
+            r->acceptes++;
+        }
+    }
+    if (r->len < r->best_len - 1e-9) {
+        r->best_len = r->len;
+        memcpy(r->best, r->tour, r->n * sizeof(int));
+    }
+}
+
+/* Température initiale : une dégradation moyenne est acceptée avec SA_ACCEPT_INIT */
+static double temperature_initiale(SA_Replique *r) {
+    int m[6];
+    double delta, somme = 0.0;
+    int nb = 0;
+    for (int i = 0; i < SA_ECHANTILLON; ++i)
+        if (tirer(r, &delta, m) != SA_AUCUN && delta > 0) {
+            somme += delta;
+            nb++;
+        }
+    if (nb == 0) return 1.0;
+    return -(somme / nb) / log(SA_ACCEPT_INIT);
+}
+
+typedef struct {
+    SA_Replique *rep;
+    int nb;
+    Solve_Context *ctx;
+    double t0, budget, T0;
+    double T;                   /* température de base (rang 0) de l'époque courante */
+    int *rang;                  /* rang[i] : position de la réplique i sur l'échelle */
+    int fini;
+    pthread_barrier_t barriere; /* nb participants : dimensionnée une fois les threads lancés */
+    pthread_mutex_t verrou;     /* départ : les threads attendent que la barrière existe */
+    pthread_cond_t depart;
+    int pret;
+    unsigned long long echanges, tentatives;
+} SA_Shared;
+
+typedef struct {
+    SA_Shared *sh;
+    int id;
+    pthread_t thread;
+} SA_Worker;
+
+/* Température de base au temps écoulé ; 1 si le budget est épuisé */
+static int planifier(SA_Shared *sh, double *T) {
+    double x = (wall_seconds() - sh->t0) / sh->budget;
+    *T = sh->T0 * pow(SA_REFROIDISSEMENT, x > 1.0 ? 1.0 : x);
+    return x >= 1.0 || solve_ctx_stop(sh->ctx);
+}
+
+/* Échanges entre rangs voisins (époques paires : 0-1, 2-3... ; impaires : 1-2, 3-4...) */
+static void echanger(SA_Shared *sh, int parite) {
+    int nb = sh->nb;
+    int *qui = malloc(nb * sizeof(int));
+    if (!qui) return;
+    for (int i = 0; i < nb; ++i)
+        qui[sh->rang[i]] = i;
+    uint64_t *rng = &sh->rep[0].rng;
+    for (int g = parite; g + 1 < nb; g += 2) {
+        int i = qui[g], j = qui[g + 1];
+        double Ti = sh->T * pow(SA_PT_RATIO, g), Tj = sh->T * pow(SA_PT_RATIO, g + 1);
+        double x = (1.0 / Ti - 1.0 / Tj) * (sh->rep[i].len - sh->rep[j].len);
+        sh->tentatives++;
+        if (x >= 0.0 || splitmix64_uniform(rng) < exp_rapide(x)) {
+            sh->rang[i] = g + 1;
+            sh->rang[j] = g;
+            sh->echanges++;
+        }
+    }
+    free(qui);
+}
+
+static void *sa_worker_main(void *arg) {
+    SA_Worker *w = arg;
+    SA_Shared *sh = w->sh;
+    SA_Replique *r = &sh->rep[w->id];
+    double meilleur_signale = r->best_len;
+
+    pthread_mutex_lock(&sh->verrou);
+    while (!sh->pret)
+        pthread_cond_wait(&sh->depart, &sh->verrou);
+    pthread_mutex_unlock(&sh->verrou);
+
+    for (int epoque = 0; ; ++epoque) {
+        double T = sh->T * pow(SA_PT_RATIO, sh->rang[w->id]);
+        for (int l = 0; l < SA_PT_EPOQUE; ++l)
+            recuire(r, T, SA_LOT);
+        if (r->best_len < meilleur_signale) {
+            meilleur_signale = r->best_len;
+            solve_ctx_report(sh->ctx, meilleur_signale);
+        }
+
+        pthread_barrier_wait(&sh->barriere);
+        if (w->id == 0) {
+            sh->fini = planifier(sh, &sh->T);
+            if (!sh->fini) echanger(sh, epoque & 1);
+        }
+        pthread_barrier_wait(&sh->barriere);
+        if (sh->fini) break;
+    }
+    return NULL;
+}
+
+int* sa_tour(const TSP_Instance *inst, double time_budget, int nb_threads, unsigned long long seed,
+             Solve_Context *ctx) {
+    int n = inst->dimension;
+    if (n <= 0 || !inst->dist) return NULL;
+
+    int *tour = nn_tour(inst, ctx);
+    if (!tour || n < 4) return tour;
+
+    if (time_budget <= 0)
+        time_budget = (ctx && ctx->deadline > 0) ? ctx->deadline - wall_seconds() : SA_BUDGET_DEFAUT;
+    if (nb_threads < 1) nb_threads = 1;
+
+    int k;
+    int *cand = build_neighbor_lists(inst, SA_K, &k);
+    SA_Replique *rep = calloc(nb_threads, sizeof(SA_Replique));
+    int *rang = malloc(nb_threads * sizeof(int));
+    int ok = (cand && rep && rang);
+
+    double len0 = tour_length(inst, tour);
+    uint64_t graine = seed ? seed : (uint64_t)time(NULL);
+    for (int t = 0; ok && t < nb_threads; ++t) {
+        SA_Replique *r = &rep[t];
+        r->inst = inst;
+        r->cand = cand;
+        r->k = k;
+        r->n = n;
+        r->tour = malloc(n * sizeof(int));
+        r->pos = malloc(n * sizeof(int));
+        r->best = malloc(n * sizeof(int));
+        ok = (r->tour && r->pos && r->best);
+        if (!ok) break;
+        // toutes les répliques partent de la tournée NN, flux décorrélés
+        memcpy(r->tour, tour, n * sizeof(int));
+        memcpy(r->best, tour, n * sizeof(int));
+        for (int i = 0; i < n; ++i)
+            r->pos[tour[i]] = i;
+        r->len = r->best_len = len0;
+        r->rng = graine + (uint64_t)t * SPLITMIX64_GAMMA;   // un flux par réplique
+        splitmix64(&r->rng);
+        rang[t] = t;
+    }
+
+    if (ok) {
+        double t_sa = stats_begin();
+        SA_Shared sh;
+        sh.rep = rep;
+        sh.nb = nb_threads;
+        sh.ctx = ctx;
+        sh.t0 = wall_seconds();
+        sh.budget = time_budget > 1e-3 ? time_budget : 1e-3;
+        sh.T0 = temperature_initiale(&rep[0]);
+        sh.T = sh.T0;
+        sh.rang = rang;
+        sh.fini = 0;
+        sh.echanges = sh.tentatives = 0;
+
+        SA_Worker *workers = (nb_threads > 1) ? calloc(nb_threads, sizeof(SA_Worker)) : NULL;
+        if (!workers) {
+            // recuit simple (un thread, ou tableau des workers non alloué) : pas de synchronisation
+            SA_Replique *r = &rep[0];
+            double T = sh.T0, meilleur_signale = r->best_len;
+            while (!planifier(&sh, &T)) {
+                recuire(r, T, SA_LOT);
+                if (r->best_len < meilleur_signale) {
+                    meilleur_signale = r->best_len;
+                    solve_ctx_report(ctx, meilleur_signale);
+                }
+            }
+        } else {
+            int started = 0;
+            for (int t = 0; t < nb_threads; ++t) {
+                workers[t].sh = &sh;
+                workers[t].id = t;
+            }
+            pthread_mutex_init(&sh.verrou, NULL);
+            pthread_cond_init(&sh.depart, NULL);
+            sh.pret = 0;
+            for (int t = 1; t < nb_threads; ++t) {
+                if (pthread_create(&workers[t].thread, NULL, sa_worker_main, &workers[t]) != 0)
+                    break;
+                started++;
+            }
+            // création incomplète : l'échelle se réduit aux répliques 0..started (rangs
+            // initiaux 0..started), les autres gardent la tournée NN
+            sh.nb = started + 1;
+            pthread_barrier_init(&sh.barriere, NULL, sh.nb);
+            pthread_mutex_lock(&sh.verrou);
+            sh.pret = 1;
+            pthread_cond_broadcast(&sh.depart);
+            pthread_mutex_unlock(&sh.verrou);
+
+            sa_worker_main(&workers[0]);
+            for (int t = 1; t <= started; ++t)
+                pthread_join(workers[t].thread, NULL);
+            pthread_barrier_destroy(&sh.barriere);
+            pthread_cond_destroy(&sh.depart);
+            pthread_mutex_destroy(&sh.verrou);
+            free(workers);
+        }
+        stats_end(STAT_IMPROVE, t_sa);
+
+        int best = 0;
+        unsigned long long essais = 0, acceptes = 0;
+        for (int t = 0; t < nb_threads; ++t) {
+            essais += rep[t].essais;
+            acceptes += rep[t].acceptes;
+            if (rep[t].best_len < rep[best].best_len) best = t;
+        }
+        memcpy(tour, rep[best].best, n * sizeof(int));
+        tour[n] = tour[0];
+        stats_add(STAT_SA_MOVES, essais);
+        stats_add(STAT_SA_ACCEPTED, acceptes);
+        stats_add(STAT_DIST_LOOKUPS, 4 * essais);
+
+        if (stats_enabled) {
+            double duree = wall_seconds() - sh.t0;
+            fprintf(stderr, "[SA] %.0f mouvements/s, %.1f%% acceptés", duree > 0 ? essais / duree : 0.0,
+                    essais ? 100.0 * acceptes / essais : 0.0);
+            if (nb_threads > 1)
+                fprintf(stderr, ", %llu/%llu échanges de répliques", sh.echanges, sh.tentatives);
+            fprintf(stderr, "\n");
+        }
+    }
+
+    for (int t = 0; rep && t < nb_threads; ++t) {
+        free(rep[t].tour);
+        free(rep[t].pos);
+        free(rep[t].best);
+    }
+    free(rep);
+    free(rang);
+    free(cand);
+    return tour;
+}
@@ -0,0 +1,298 @@
+/* batch.c
+ * Mode batch (-b) : exécute une liste de couples (instance, méthode) dans un seul processus.
+ * Les jobs d'une même instance sont regroupés : l'instance est lue et sa matrice des
+ * distances construite une seule fois, puis libérée après son dernier job. Un plafond
+ * mémoire borne le nombre d'instances chargées en même temps.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <pthread.h>
+#include "batch.h"
+#include "tsp_parser.h"
+#include "algo_nn.h"
+#include "csv_export.h"
+#include "lower_bound.h"
+#include "thread_pool.h"
+
+extern volatile sig_atomic_t stop_requested;
+
+#define BATCH_LIGNE_MAX 1024
+
+typedef enum { INST_ABSENTE, INST_CHARGEMENT, INST_PRETE, INST_ERREUR } Batch_Etat;
+
+typedef struct {
+    char *path;
+    double octets;              /* estimation de la place occupée une fois chargée */
+    int jobs_restants;
+    Batch_Etat etat;
+    TSP_Instance *inst;
+    double lb;                  /* borne de Held-Karp, calculée au chargement */
+} Batch_Instance;
+
+typedef struct {
+    int instance;
+    char methode[32];
+    Solver_Params params;
+} Batch_Job;
+
+typedef struct {
+    Batch_Instance *instances;
+    int nb_instances;
+    Batch_Job *jobs;
+    int nb_jobs;
+    const char *csv_file;
+    double mem_max;
+    double mem_utilisee;
+    int entete;                 /* prochaine ligne CSV : avec entête */
+    int borne;                  /* borne de Held-Karp calculée au chargement */
+    int nb_erreurs;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;        /* chargement terminé ou mémoire libérée */
+} Batch;
+
+/* Dimension lue dans l'entête du fichier (0 si introuvable) */
+static long read_dimension(const char *path) {
+    FILE *fp = fopen(path, "r");
+    if (!fp) return 0;
+    char ligne[BATCH_LIGNE_MAX];
+    long n = 0;
+    while (fgets(ligne, sizeof(ligne), fp)) {
+        if (!strncmp(ligne, "NODE_COORD_SECTION", 18)) break;
+        if (!strncmp(ligne, "DIMENSION", 9)) {
+            char *p = strchr(ligne, ':');
+            n = atol(p ? p + 1 : ligne + 9);
+            break;
+        }
+    }
+    fclose(fp);
+    return n;
+}
+
+static int find_or_add_instance(Batch *b, const char *path) {
+    for (int i = 0; i < b->nb_instances; ++i)
+        if (!strcmp(b->instances[i].path, path))
+            return i;
+
+    Batch_Instance *tab = realloc(b->instances, (b->nb_instances + 1) * sizeof(Batch_Instance));
+    if (!tab) return -1;
+    b->instances = tab;
+    Batch_Instance *bi = &tab[b->nb_instances];
+    memset(bi, 0, sizeof(*bi));
+    bi->path = strdup(path);
+    if (!bi->path) return -1;
+    long n = read_dimension(path);
+    bi->octets = (double)n * n * sizeof(double) + 2.0 * n * sizeof(double) + sizeof(TSP_Instance);
+    return b->nb_instances++;
+}
+
+static int add_job(Batch *b, int instance, const char *methode, const Solver_Params *p) {
+    Batch_Job *tab = realloc(b->jobs, (b->nb_jobs + 1) * sizeof(Batch_Job));
+    if (!tab) return 0;
+    b->jobs = tab;
+    Batch_Job *j = &tab[b->nb_jobs++];
+    j->instance = instance;
+    snprintf(j->methode, sizeof(j->methode), "%s", methode);
+    j->params = *p;
+    b->instances[instance].jobs_restants++;
+    return 1;
+}
+
+/* Lecture du fichier de jobs ; les lignes invalides sont signalées et ignorées */
+static int read_jobs(Batch *b, const char *jobs_file, const Solver_Params *defaults) {
+    FILE *fp = fopen(jobs_file, "r");
+    if (!fp) {
+        perror("Erreur ouverture fichier de jobs");
+        return 0;
+    }
+
+    char ligne[BATCH_LIGNE_MAX];
+    int num = 0;
+    while (fgets(ligne, sizeof(ligne), fp)) {
+        num++;
+        char *tok[6];
+        int nb = 0;
+        for (char *t = strtok(ligne, " \t\r\n"); t && nb < 6; t = strtok(NULL, " \t\r\n"))
+            tok[nb++] = t;
+        if (nb == 0 || tok[0][0] == '#')
+            continue;
+
+        if (nb < 2 || (strcmp(tok[1], "all") && !solver_is_method(tok[1]))) {
+            fprintf(stderr, "[batch] ligne %d ignorée : méthode absente ou inconnue\n", num);
+            b->nb_erreurs++;
+            continue;
+        }
+
+        Solver_Params p = *defaults;
+        if (solver_needs_ga_params(tok[1])) {
+            if (nb < 5) {
+                fprintf(stderr, "[batch] ligne %d ignorée : %s demande <pop> <gen> <mut>\n", num, tok[1]);
+                b->nb_erreurs++;
+                continue;
+            }
+            p.pop_size = atoi(tok[2]);
+            p.generations = atoi(tok[3]);
+            p.mut_rate = atof(tok[4]);
+        }
+
+        int inst = find_or_add_instance(b, tok[0]);
+        if (inst < 0) break;
+        if (!strcmp(tok[1], "all")) {
+            for (int k = 0; k < SOLVER_ALL_NB; ++k)
+                if (!add_job(b, inst, solver_all_methodes[k], &p)) break;
+        } else if (!add_job(b, inst, tok[1], &p)) {
+            break;
+        }
+    }
+    fclose(fp);
+
+    // Regroupement par instance (ordre de première apparition, ordre des lignes conservé)
+    Batch_Job *tries = malloc(b->nb_jobs * sizeof(Batch_Job));
+    if (!tries) return b->nb_jobs == 0;
+    int k = 0;
+    for (int i = 0; i < b->nb_instances; ++i)
+        for (int j = 0; j < b->nb_jobs; ++j)
+            if (b->jobs[j].instance == i)
+                tries[k++] = b->jobs[j];
+    free(b->jobs);
+    b->jobs = tries;
+    return 1;
+}
+
+/* Rend l'instance du job disponible (chargement ou attente) ; NULL si illisible */
+static TSP_Instance *acquire_instance(Batch *b, Batch_Instance *bi) {
+    pthread_mutex_lock(&b->lock);
+    for (;;) {
+        if (bi->etat == INST_PRETE || bi->etat == INST_ERREUR)
+            break;
+        if (bi->etat == INST_ABSENTE &&
+            (b->mem_utilisee == 0 || b->mem_utilisee + bi->octets <= b->mem_max)) {
+            // ce thread charge l'instance, hors verrou
+            bi->etat = INST_CHARGEMENT;
+            b->mem_utilisee += bi->octets;
+            pthread_mutex_unlock(&b->lock);
+
+            TSP_Instance *inst = tsp_read_file(bi->path);
+            double lb = 0.0;
+            if (inst && b->borne)
+                lb = held_karp_bound(inst, NULL);   // une fois par instance
+
+            pthread_mutex_lock(&b->lock);
+            bi->inst = inst;
+            bi->lb = lb;
+            bi->etat = inst ? INST_PRETE : INST_ERREUR;
+            if (!inst) b->mem_utilisee -= bi->octets;
+            pthread_cond_broadcast(&b->cond);
+            break;
+        }
+        // instance en cours de chargement ailleurs, ou plafond mémoire atteint
+        pthread_cond_wait(&b->cond, &b->lock);
+    }
+    TSP_Instance *inst = bi->inst;
+    pthread_mutex_unlock(&b->lock);
+    return inst;
+}
+
+static void release_instance(Batch *b, Batch_Instance *bi) {
+    pthread_mutex_lock(&b->lock);
+    if (--bi->jobs_restants == 0 && bi->inst) {
+        tsp_free_instance(bi->inst);
+        bi->inst = NULL;
+        bi->etat = INST_ABSENTE;
+        b->mem_utilisee -= bi->octets;
+        pthread_cond_broadcast(&b->cond);
+    }
+    pthread_mutex_unlock(&b->lock);
+}
+
+static void batch_task(void *arg, int idx, int worker) {
+    (void)worker;
+    Batch *b = arg;
+    Batch_Job *job = &b->jobs[idx];
+    Batch_Instance *bi = &b->instances[job->instance];
+
+    if (stop_requested) {
+        release_instance(b, bi);
+        return;
+    }
+
+    TSP_Instance *inst = acquire_instance(b, bi);
+    if (!inst) {
+        pthread_mutex_lock(&b->lock);
+        fprintf(stderr, "[batch] %s : lecture impossible, job %s ignoré\n", bi->path, job->methode);
+        b->nb_erreurs++;
+        pthread_mutex_unlock(&b->lock);
+        release_instance(b, bi);
+        return;
+    }
+
+    double t0 = wall_seconds();
+    int *tour = solver_run(job->methode, inst, &job->params, NULL);
+    double elapsed = wall_seconds() - t0;
+
+    // ligne CSV formatée hors verrou ; seule l'écriture est sérialisée
+    double length = tour ? tour_length(inst, tour) : 0.0;
+    Tour_Buffer ligne;
+    tour_buf_init(&ligne);
+    if (tour && b->csv_file)
+        summary_csv_format(&ligne, inst->name, job->methode, elapsed, length, bi->lb, tour, inst->dimension, 0);
+
+    pthread_mutex_lock(&b->lock);
+    if (tour) {
+        printf("%s ; %s ; %.0f ; %.3fs\n", inst->name, job->methode, length, elapsed);
+        fflush(stdout);
+        if (b->csv_file) {
+            if (b->entete) {
+                Tour_Buffer entete;
+                tour_buf_init(&entete);
+                tour_buf_str(&entete, CSV_ENTETE_RESUME);
+                tour_buf_write_file(&entete, b->csv_file, 0);
+                tour_buf_free(&entete);
+            }
+            tour_buf_write_file(&ligne, b->csv_file, 1);
+            b->entete = 0;
+        }
+    } else {
+        fprintf(stderr, "[batch] %s : échec de %s\n", inst->name, job->methode);
+        b->nb_erreurs++;
+    }
+    pthread_mutex_unlock(&b->lock);
+
+    tour_buf_free(&ligne);
+    free(tour);
+    release_instance(b, bi);
+}
+
+int batch_run(const char *jobs_file, const char *csv_file, const Solver_Params *defaults,
+              int nb_workers, double mem_max, int borne) {
+    Batch b;
+    memset(&b, 0, sizeof(b));
+    b.csv_file = csv_file;
+    b.mem_max = mem_max;
+    b.borne = borne;
+    b.entete = 1;
+
+    int ok = read_jobs(&b, jobs_file, defaults);
+    if (ok && b.nb_jobs > 0) {
+        pthread_mutex_init(&b.lock, NULL);
+        pthread_cond_init(&b.cond, NULL);
+
+        double t0 = wall_seconds();
+        pool_run(b.nb_jobs, nb_workers, batch_task, &b);
+        fprintf(stderr, "[batch] %d jobs, %d instances, %.3fs\n",
+                b.nb_jobs, b.nb_instances, wall_seconds() - t0);
+
+        pthread_cond_destroy(&b.cond);
+        pthread_mutex_destroy(&b.lock);
+    }
+
+    for (int i = 0; i < b.nb_instances; ++i) {
+        if (b.instances[i].inst) tsp_free_instance(b.instances[i].inst);
+        free(b.instances[i].path);
+    }
+    free(b.instances);
+    free(b.jobs);
+    return ok && b.nb_erreurs == 0 && !stop_requested;
+}
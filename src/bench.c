@@ -0,0 +1,252 @@
+/* bench.c
+ * Banc de mesure (--bench) : répète chaque méthode sur un corpus d'instances et
+ * résume temps et longueurs (min / médiane / p95), avec l'écart aux optimums connus.
+ * Résultats sur stdout, et en CSV / JSON pour comparer les performances entre commits.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <signal.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include "bench.h"
+#include "tsp_parser.h"
+#include "algo_nn.h"
+#include "thread_pool.h"
+
+extern volatile sig_atomic_t stop_requested;
+
+/* Optimums publiés (TSPLIB) ; att10 et att15 ont été calculés avec -m hk */
+static const struct { const char *nom; double optimum; } optimums[] = {
+    {"att10", 6178},     {"att15", 6443},     {"att48", 10628},    {"att532", 27686},
+    {"berlin52", 7542},  {"burma14", 3323},   {"ulysses16", 6859}, {"ulysses22", 7013},
+    {"eil51", 426},      {"eil76", 538},      {"eil101", 629},     {"st70", 675},
+    {"pr76", 108159},    {"kroA100", 21282},  {"kroB100", 22141},  {"lin105", 14379},
+    {"ch130", 6110},     {"ch150", 6528},     {"a280", 2579},      {"pcb442", 50778},
+    {"gr96", 55209},     {"gr202", 40160},    {"gr666", 294358},   {"rat99", 1211},
+};
+
+static double known_optimum(const char *nom) {
+    for (size_t i = 0; i < sizeof(optimums) / sizeof(optimums[0]); ++i)
+        if (!strcmp(nom, optimums[i].nom))
+            return optimums[i].optimum;
+    return 0.0;
+}
+
+typedef struct {
+    char instance[128];
+    int dimension;
+    char methode[32];
+    int runs;
+    double t_min, t_med, t_p95;
+    double l_min, l_med, l_p95;
+    double optimum;             /* 0 si inconnu */
+} Bench_Row;
+
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/* min / médiane / p95 (rang le plus proche) ; v est trié en place */
+static void summarize(double *v, int n, double *min, double *med, double *p95) {
+    qsort(v, n, sizeof(double), cmp_double);
+    *min = v[0];
+    *med = (n % 2) ? v[n / 2] : 0.5 * (v[n / 2 - 1] + v[n / 2]);
+    int r = (int)ceil(0.95 * n);
+    *p95 = v[(r > 0 ? r : 1) - 1];
+}
+
+static int ends_with_tsp(const char *nom) {
+    size_t l = strlen(nom);
+    return l > 4 && !strcmp(nom + l - 4, ".tsp");
+}
+
+static int filter_tsp(const struct dirent *e) {
+    return ends_with_tsp(e->d_name);
+}
+
+/* Développe le corpus en liste de fichiers (répertoires triés par nom) */
+static char **collect_files(const Bench_Options *opt, int *nb) {
+    char **files = NULL;
+    *nb = 0;
+    for (int c = 0; c < opt->nb_corpus; ++c) {
+        const char *p = opt->corpus[c];
+        struct stat st;
+        if (stat(p, &st) == 0 && S_ISDIR(st.st_mode)) {
+            struct dirent **liste;
+            int k = scandir(p, &liste, filter_tsp, alphasort);
+            for (int i = 0; i < k; ++i) {
+                char **tab = realloc(files, (*nb + 1) * sizeof(char *));
+                if (tab) {
+                    files = tab;
+                    size_t len = strlen(p) + strlen(liste[i]->d_name) + 2;
+                    if ((files[*nb] = malloc(len))) {
+                        snprintf(files[*nb], len, "%s/%s", p, liste[i]->d_name);
+                        (*nb)++;
+                    }
+                }
+                free(liste[i]);
+            }
+            if (k >= 0) free(liste);
+        } else {
+            char **tab = realloc(files, (*nb + 1) * sizeof(char *));
+            if (tab && (tab[*nb] = strdup(p))) {
+                files = tab;
+                (*nb)++;
+            } else if (tab) {
+                files = tab;
+            }
+        }
+    }
+    return files;
+}
+
+/* Mesure une méthode sur une instance ; retourne 0 si une exécution a échoué */
+static int bench_one(const TSP_Instance *inst, const char *methode, const Bench_Options *opt,
+                     const Solver_Params *params, Bench_Row *row) {
+    int R = opt->repetitions;
+    double *temps = malloc(R * sizeof(double));
+    double *longueurs = malloc(R * sizeof(double));
+    int ok = (temps && longueurs);
+    row->runs = 0;          // la ligne est réutilisée après l'échec d'une méthode
+
+    Solver_Params p = *params;
+    for (int i = -opt->warmup; ok && i < R && !stop_requested; ++i) {
+        p.seed = opt->seed + (unsigned int)(i < 0 ? 0 : i);
+        double t0 = wall_seconds();
+        int *tour = solver_run(methode, inst, &p, NULL);
+        double t = wall_seconds() - t0;
+        if (!tour) {
+            ok = 0;
+            break;
+        }
+        if (i >= 0) {
+            temps[i] = t;
+            longueurs[i] = tour_length(inst, tour);
+            row->runs = i + 1;
+        }
+        free(tour);
+    }
+
+    if (ok && row->runs > 0) {
+        summarize(temps, row->runs, &row->t_min, &row->t_med, &row->t_p95);
+        summarize(longueurs, row->runs, &row->l_min, &row->l_med, &row->l_p95);
+    }
+    free(temps);
+    free(longueurs);
+    return ok && row->runs > 0;
+}
+
+static double gap(double l, double opt) {
+    return 100.0 * (l - opt) / opt;
+}
+
+static void write_csv(const char *filename, const Bench_Row *rows, int nb) {
+    FILE *fp = fopen(filename, "w");
+    if (!fp) {
+        perror("Erreur ouverture fichier CSV");
+        return;
+    }
+    fprintf(fp, "instance;n;méthode;runs;temps_min;temps_med;temps_p95;"
+                "long_min;long_med;long_p95;optimum;ecart_min(%%);ecart_med(%%)\n");
+    for (int i = 0; i < nb; ++i) {
+        const Bench_Row *r = &rows[i];
+        fprintf(fp, "%s;%d;%s;%d;%.6f;%.6f;%.6f;%.0f;%.0f;%.0f;", r->instance, r->dimension, r->methode,
+                r->runs, r->t_min, r->t_med, r->t_p95, r->l_min, r->l_med, r->l_p95);
+        if (r->optimum > 0)
+            fprintf(fp, "%.0f;%.4f;%.4f\n", r->optimum, gap(r->l_min, r->optimum), gap(r->l_med, r->optimum));
+        else
+            fprintf(fp, ";;\n");
+    }
+    fclose(fp);
+}
+
+static void write_json(const char *filename, const Bench_Options *opt, const Bench_Row *rows, int nb) {
+    FILE *fp = fopen(filename, "w");
+    if (!fp) {
+        perror("Erreur ouverture fichier JSON");
+        return;
+    }
+    fprintf(fp, "{\n  \"repetitions\": %d,\n  \"warmup\": %d,\n  \"seed\": %u,\n  \"results\": [\n",
+            opt->repetitions, opt->warmup, opt->seed);
+    for (int i = 0; i < nb; ++i) {
+        const Bench_Row *r = &rows[i];
+        fprintf(fp, "    {\"instance\": \"%s\", \"n\": %d, \"method\": \"%s\", \"runs\": %d, "
+                    "\"time\": {\"min\": %.6f, \"median\": %.6f, \"p95\": %.6f}, "
+                    "\"length\": {\"min\": %.0f, \"median\": %.0f, \"p95\": %.0f}, ",
+                r->instance, r->dimension, r->methode, r->runs, r->t_min, r->t_med, r->t_p95,
+                r->l_min, r->l_med, r->l_p95);
+        if (r->optimum > 0)
+            fprintf(fp, "\"optimum\": %.0f, \"gap_min\": %.4f, \"gap_median\": %.4f}",
+                    r->optimum, gap(r->l_min, r->optimum), gap(r->l_med, r->optimum));
+        else
+            fprintf(fp, "\"optimum\": null, \"gap_min\": null, \"gap_median\": null}");
+        fprintf(fp, "%s\n", (i + 1 < nb) ? "," : "");
+    }
+    fprintf(fp, "  ]\n}\n");
+    fclose(fp);
+}
+
+int bench_run(const Bench_Options *opt, const Solver_Params *params) {
+    int nb_files;
+    char **files = collect_files(opt, &nb_files);
+    if (nb_files == 0) {
+        fprintf(stderr, "[bench] corpus vide\n");
+        free(files);
+        return 1;
+    }
+
+    // Liste des méthodes
+    char *liste = strdup(opt->methodes);
+    char *methodes[64];
+    int nb_methodes = 0;
+    for (char *m = strtok(liste, ","); m && nb_methodes < 64; m = strtok(NULL, ","))
+        if (solver_is_method(m)) methodes[nb_methodes++] = m;
+        else fprintf(stderr, "[bench] méthode inconnue ignorée : %s\n", m);
+
+    Bench_Row *rows = calloc((size_t)nb_files * (nb_methodes ? nb_methodes : 1), sizeof(Bench_Row));
+    int nb_rows = 0, erreurs = 0;
+
+    printf("%-12s %6s %-9s %4s %10s %10s %10s %10s %10s %8s\n", "instance", "n", "méthode", "runs",
+           "t_min(s)", "t_med(s)", "t_p95(s)", "l_min", "l_med", "écart");
+    for (int f = 0; rows && f < nb_files && !stop_requested; ++f) {
+        TSP_Instance *inst = tsp_read_file(files[f]);
+        if (!inst) {
+            fprintf(stderr, "[bench] %s : lecture impossible\n", files[f]);
+            erreurs++;
+            continue;
+        }
+        for (int m = 0; m < nb_methodes && !stop_requested; ++m) {
+            Bench_Row *r = &rows[nb_rows];
+            snprintf(r->instance, sizeof(r->instance), "%s", inst->name);
+            snprintf(r->methode, sizeof(r->methode), "%s", methodes[m]);
+            r->dimension = inst->dimension;
+            r->optimum = known_optimum(inst->name);
+            if (!bench_one(inst, methodes[m], opt, params, r)) {
+                fprintf(stderr, "[bench] %s / %s : échec\n", inst->name, methodes[m]);
+                erreurs++;
+                continue;
+            }
+            nb_rows++;
+            printf("%-12s %6d %-9s %4d %10.4f %10.4f %10.4f %10.0f %10.0f ", r->instance, r->dimension,
+                   r->methode, r->runs, r->t_min, r->t_med, r->t_p95, r->l_min, r->l_med);
+            if (r->optimum > 0) printf("%7.2f%%\n", gap(r->l_med, r->optimum));
+            else printf("%8s\n", "-");
+            fflush(stdout);
+        }
+        tsp_free_instance(inst);
+    }
+
+    if (opt->csv_file) write_csv(opt->csv_file, rows, nb_rows);
+    if (opt->json_file) write_json(opt->json_file, opt, rows, nb_rows);
+
+    for (int f = 0; f < nb_files; ++f)
+        free(files[f]);
+    free(files);
+    free(liste);
+    free(rows);
+    return erreurs ? 1 : 0;
+}
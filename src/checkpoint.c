@@ -0,0 +1,82 @@
+/* checkpoint.c
+ * Sauvegarde atomique (fichier temporaire + rename) et relecture validée des états
+ * de résolution. Le contenu de l'état est propre à chaque algorithme.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "checkpoint.h"
+#include "tour_io.h"
+#include "hash.h"
+
+#define CK_MAGIC "TSPC"
+
+int checkpoint_write(const char *file, const char type[4], const void *data, size_t len) {
+    Tour_Buffer b;
+    tour_buf_init(&b);
+    uint64_t taille = len, somme = fnv1a(FNV_INIT, data, len);
+    tour_buf_bytes(&b, CK_MAGIC, 4);
+    tour_buf_bytes(&b, type, 4);
+    tour_buf_bytes(&b, &taille, sizeof(taille));
+    tour_buf_bytes(&b, data, len);
+    tour_buf_bytes(&b, &somme, sizeof(somme));
+
+    size_t l = strlen(file);
+    char *tmp = malloc(l + 5);
+    int r = -1;
+    if (tmp) {
+        memcpy(tmp, file, l);
+        memcpy(tmp + l, ".tmp", 5);
+        int fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd >= 0) {
+            r = tour_buf_write_fd(&b, fd);
+            if (r == 0) r = fsync(fd);
+            if (close(fd) != 0) r = -1;
+            if (r == 0) r = rename(tmp, file);
+            if (r != 0) unlink(tmp);
+        }
+        if (r != 0) perror(file);
+        free(tmp);
+    }
+    tour_buf_free(&b);
+    return r;
+}
+
+void *checkpoint_read(const char *file, const char type[4], size_t *len) {
+    FILE *fp = fopen(file, "rb");
+    if (!fp) return NULL;
+    char entete[8];
+    uint64_t taille, somme;
+    void *data = NULL;
+    if (fread(entete, 1, 8, fp) == 8 && !memcmp(entete, CK_MAGIC, 4) && !memcmp(entete + 4, type, 4) &&
+        fread(&taille, sizeof(taille), 1, fp) == 1 && taille < ((uint64_t)1 << 40)) {
+        data = malloc(taille ? taille : 1);
+        if (data && (fread(data, 1, taille, fp) != taille || fread(&somme, sizeof(somme), 1, fp) != 1 ||
+                     somme != fnv1a(FNV_INIT, data, taille))) {
+            free(data);
+            data = NULL;
+        }
+        if (data) *len = taille;
+    }
+    fclose(fp);
+    if (!data) fprintf(stderr, "%s : sauvegarde invalide ou d'un autre type\n", file);
+    return data;
+}
+
+uint64_t checkpoint_signature(const TSP_Instance *inst) {
+    uint64_t h = fnv1a(FNV_INIT, &inst->dimension, sizeof(inst->dimension));
+    h = fnv1a(h, &inst->dist_type, sizeof(inst->dist_type));
+    h = fnv1a(h, inst->x, (size_t)inst->dimension * sizeof(double));
+    return fnv1a(h, inst->y, (size_t)inst->dimension * sizeof(double));
+}
+
+int checkpoint_get(Checkpoint_Reader *r, void *dst, size_t len) {
+    if (len > r->reste) return 0;
+    memcpy(dst, r->p, len);
+    r->p += len;
+    r->reste -= len;
+    return 1;
+}
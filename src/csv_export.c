@@ -1,8 +1,56 @@
 #include <stdio.h>
-#include <time.h>  // pour mesurer le temps ailleurs
 #include "csv_export.h"
+#include "lower_bound.h"
 
 
+/**
+ * @brief Exporte une tournée seule au format CSV (une ville par ligne).
+ *
+ * @param filename   Nom du fichier de sortie (écrasé).
+ * @param tour       Tournée (villes 0..n-1) ; la première ville est répétée en fin de fichier.
+ * @param n          Dimension (nombre de villes dans le problème).
+ *
+ * @return 0 si succès, -1 si erreur d'écriture.
+ */
+int export_tour_csv(const char *filename, const int *tour, int n) {
+    Tour_Buffer b;
+    tour_buf_init(&b);
+    tour_buf_str(&b, "position;ville\n");
+    for (int i = 0; i <= n; ++i) {
+        tour_buf_int(&b, i + 1);
+        tour_buf_str(&b, ";");
+        tour_buf_int(&b, tour[i % n] + 1);
+        tour_buf_str(&b, "\n");
+    }
+    int r = tour_buf_write_file(&b, filename, 0);
+    tour_buf_free(&b);
+    return r;
+}
+
+void summary_csv_format(Tour_Buffer *b, const char *instance, const char *method,
+                        double time_sec, double length, double lb, const int *tour, int n, int entete) {
+    if (entete)
+        tour_buf_str(b, CSV_ENTETE_RESUME);
+    tour_buf_str(b, instance);
+    tour_buf_str(b, ";");
+    tour_buf_str(b, method);
+    tour_buf_str(b, ";");
+    tour_buf_double(b, time_sec, 2);
+    tour_buf_str(b, ";");
+    tour_buf_double(b, length, 0);
+    tour_buf_str(b, ";");
+    if (lb > 0.0) {         // sans borne (-nolb, échéance, -dc) : champs vides
+        tour_buf_double(b, lb, 0);
+        tour_buf_str(b, ";");
+        tour_buf_double(b, optimality_gap(length, lb), 4);
+    } else {
+        tour_buf_str(b, ";");
+    }
+    tour_buf_str(b, ";[");
+    tour_buf_cities(b, tour, n, ',', 1);
+    tour_buf_str(b, "]\n");
+}
+
 /**
  * @brief Exporte un résumé de la tournée au format CSV.
  *
@@ -11,6 +59,8 @@
  * @param method     Nom de l’algorithme utilisé (ex: "nn", "bf").
  * @param time_sec   Temps d'exécution (en secondes).
  * @param length     Longueur totale de la tournée.
+ * @param lb         Borne inférieure (Held-Karp) ; l'écart (length - lb) / lb est exporté,
+ *                   les deux champs restent vides si lb <= 0 (pas de borne).
  * @param tour       Tableau contenant la tournée (liste ordonnée des villes visitées).
  * @param n          Dimension (nombre de villes dans le problème).
  * @param entete     1 pour insérer l'entête (et écraser le fichier), 0 sinon
@@ -18,21 +68,11 @@
  * @return 0 si succès, -1 si erreur à l'ouverture du fichier.
  */
 int export_summary_csv(const char *filename, const char *instance, const char *method,
-                       double time_sec, double length, const int *tour, int n, int entete) {
-    FILE *fp = fopen(filename, entete ? "w" : "a"); // si pas d'entete, on fait append au fichier
-    if (!fp) {
-        perror("Erreur ouverture fichier CSV");
-        return -1;
-    }
-    if (entete){
-        fprintf(fp, "instance;méthode;durée(s);longueur;tournee\n");
-    }
-    fprintf(fp, "%s;%s;%.2f;%.0f;[", instance, method, time_sec, length);
-
-    for (int i = 0; i <= n; ++i)
-        fprintf(fp, "%d%s", tour[i] + 1, (i < n) ? "," : "");
-
-    fprintf(fp, "]\n");
-    fclose(fp);
-    return 0;
+                       double time_sec, double length, double lb, const int *tour, int n, int entete) {
+    Tour_Buffer b;
+    tour_buf_init(&b);
+    summary_csv_format(&b, instance, method, time_sec, length, lb, tour, n, entete);
+    int r = tour_buf_write_file(&b, filename, !entete); // si pas d'entete, on fait append au fichier
+    tour_buf_free(&b);
+    return r;
 }
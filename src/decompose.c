@@ -0,0 +1,446 @@
+/* decompose.c
+ * Décomposition géométrique : partition de Karp, résolution des clusters en parallèle
+ * sur des sous-instances, fusion des cycles, réoptimisation des jonctions.
+ * Aucune structure en O(n²) : mémoire en O(n + nb_threads * taille_cluster²).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "decompose.h"
+#include "distance.h"
+#include "tsp_parser.h"
+#include "renumber.h"
+#include "thread_pool.h"
+#include "algo_nn.h"
+#include "stats.h"
+
+#define DC_BORD         32      /* villes de frontière essayées par cluster à la fusion */
+#define DC_DEMI_FENETRE 50      /* villes de part et d'autre d'une jonction */
+#define DC_FENETRE_MAX  (4 * DC_DEMI_FENETRE)
+#define DC_OR_MAX       3       /* longueur maximale des segments Or-opt */
+
+typedef struct {
+    int debut;                  /* villes du cluster : idx[debut .. debut + taille) */
+    int taille;
+    double cx, cy;              /* centre */
+} Cluster;
+
+typedef struct {
+    const TSP_Instance *inst;
+    const char *methode;
+    Solver_Params params;       /* copie mono-thread, sans sauvegarde ni trace */
+    Solve_Context *ctx;
+    int *idx;                   /* villes regroupées par cluster ; après résolution, */
+    Cluster *clusters;          /* idx[debut..] contient le cycle du cluster */
+    int nb_clusters;
+    int *tour;                  /* tournée globale (n + 1) */
+    int *jonctions;             /* villes dont le successeur a changé à la fusion */
+    int *fenetres;              /* (début, longueur) des fenêtres réoptimisées */
+} DC;
+
+/* ---------- partition de Karp ---------- */
+
+static inline double coord(const TSP_Instance *inst, int v, int axe) {
+    return axe ? inst->y[v] : inst->x[v];
+}
+
+/* Sélection rapide : après l'appel, idx[k] est la ville de rang k selon l'axe,
+ * les villes de rang inférieur avant, les autres après */
+static void selection(const TSP_Instance *inst, int *idx, int lo, int hi, int k, int axe) {
+    while (hi - lo > 1) {
+        double pivot = coord(inst, idx[lo + (hi - lo) / 2], axe);
+        int i = lo, j = hi - 1;
+        while (i <= j) {
+            while (coord(inst, idx[i], axe) < pivot) i++;
+            while (coord(inst, idx[j], axe) > pivot) j--;
+            if (i <= j) {
+                int t = idx[i];
+                idx[i] = idx[j];
+                idx[j] = t;
+                i++;
+                j--;
+            }
+        }
+        if (k <= j) hi = j + 1;
+        else if (k >= i) lo = i;
+        else return;
+    }
+}
+
+static void partitionner(const TSP_Instance *inst, int *idx, int lo, int hi, int taille,
+                         Cluster *out, int *nb) {
+    if (hi - lo <= taille) {
+        Cluster *c = &out[(*nb)++];
+        c->debut = lo;
+        c->taille = hi - lo;
+        c->cx = c->cy = 0.0;
+        for (int i = lo; i < hi; ++i) {
+            c->cx += inst->x[idx[i]];
+            c->cy += inst->y[idx[i]];
+        }
+        c->cx /= c->taille;
+        c->cy /= c->taille;
+        return;
+    }
+    double xmin = inst->x[idx[lo]], xmax = xmin, ymin = inst->y[idx[lo]], ymax = ymin;
+    for (int i = lo + 1; i < hi; ++i) {
+        double x = inst->x[idx[i]], y = inst->y[idx[i]];
+        if (x < xmin) xmin = x;
+        if (x > xmax) xmax = x;
+        if (y < ymin) ymin = y;
+        if (y > ymax) ymax = y;
+    }
+    int mid = lo + (hi - lo) / 2;
+    selection(inst, idx, lo, hi, mid, (ymax - ymin) > (xmax - xmin));
+    partitionner(inst, idx, lo, mid, taille, out, nb);
+    partitionner(inst, idx, mid, hi, taille, out, nb);
+}
+
+/* ---------- résolution des clusters ---------- */
+
+static void resoudre_cluster(void *arg, int c, int worker) {
+    (void)worker;
+    DC *dc = arg;
+    const TSP_Instance *inst = dc->inst;
+    Cluster *cl = &dc->clusters[c];
+    int *villes = dc->idx + cl->debut;
+    int m = cl->taille;
+    if (m <= 3) return;         // tout ordre est optimal
+
+    double *xs = malloc(m * sizeof(double));
+    double *ys = malloc(m * sizeof(double));
+    int *copie = malloc(m * sizeof(int));
+    TSP_Instance *sub = NULL;
+    if (xs && ys && copie) {
+        for (int i = 0; i < m; ++i) {
+            xs[i] = inst->x[villes[i]];
+            ys[i] = inst->y[villes[i]];
+        }
+        sub = tsp_from_coords(inst->name, inst->dist_type, m, xs, ys);
+    }
+    if (sub) {
+        // échéance commune ; arrêt déjà demandé : simple tournée NN du cluster
+        int *t;
+        if (solve_ctx_stop(dc->ctx)) {
+            t = nn_tour(sub, NULL);
+        } else {
+            Solve_Context sous;
+            double reste = 0.0;      // pas d'échéance
+            if (dc->ctx && dc->ctx->deadline > 0) {
+                reste = dc->ctx->deadline - wall_seconds();
+                if (reste < 1e-9) reste = 1e-9;
+            }
+            solve_ctx_init(&sous, reste, NULL, NULL);
+            t = solver_run(dc->methode, sub, &dc->params, &sous);
+            solve_ctx_destroy(&sous);
+        }
+        if (t) {
+            memcpy(copie, villes, m * sizeof(int));
+            for (int i = 0; i < m; ++i)
+                villes[i] = copie[t[i]];
+            free(t);
+        }
+        tsp_free_instance(sub);
+    }
+    free(xs);
+    free(ys);
+    free(copie);
+}
+
+/* ---------- fusion des cycles ---------- */
+
+/* Les DC_BORD villes de villes[0..m) les plus proches de (x, y), dans out ; retourne leur nombre */
+static int bord(const TSP_Instance *inst, const int *villes, int m, double x, double y, int *out) {
+    double dbord[DC_BORD];
+    int nb = 0;
+    for (int i = 0; i < m; ++i) {
+        int v = villes[i];
+        double dx = inst->x[v] - x, dy = inst->y[v] - y, d = dx * dx + dy * dy;
+        if (nb == DC_BORD && d >= dbord[nb - 1]) continue;
+        int j = (nb < DC_BORD) ? nb++ : nb - 1;
+        while (j > 0 && dbord[j - 1] > d) {
+            dbord[j] = dbord[j - 1];
+            out[j] = out[j - 1];
+            j--;
+        }
+        dbord[j] = d;
+        out[j] = v;
+    }
+    return nb;
+}
+
+/* Fusionne les cycles des clusters dans l'ordre ordre[] (succ/pred sur les villes) : le
+ * cycle du cluster suivant est rattaché en échangeant une arête (a, b) déjà dans la
+ * tournée et une arête (c, d) du nouveau cycle contre (a, d) + (c, b), ou (a, c) + (d, b)
+ * en inversant le nouveau cycle. Seules les arêtes touchant les villes proches de la
+ * frontière entre les deux clusters sont essayées. Les villes a et c ou d dont le
+ * successeur change sont notées dans jonctions (2 par fusion). */
+static void fusionner(DC *dc, const int *ordre, int *succ, int *pred) {
+    const TSP_Instance *inst = dc->inst;
+    int m = dc->nb_clusters;
+    for (int c = 0; c < m; ++c) {
+        const Cluster *cl = &dc->clusters[c];
+        const int *cyc = dc->idx + cl->debut;
+        for (int i = 0; i < cl->taille; ++i) {
+            succ[cyc[i]] = cyc[(i + 1) % cl->taille];
+            pred[cyc[(i + 1) % cl->taille]] = cyc[i];
+        }
+    }
+
+    int ba[DC_BORD], bb[DC_BORD];
+    for (int k = 1; k < m; ++k) {
+        const Cluster *A = &dc->clusters[ordre[k - 1]], *B = &dc->clusters[ordre[k]];
+        int na = bord(inst, dc->idx + A->debut, A->taille, B->cx, B->cy, ba);
+        int nb = bord(inst, dc->idx + B->debut, B->taille, A->cx, A->cy, bb);
+
+        double best = 0.0;
+        int ma = -1, mc = -1, inverse = 0;
+        for (int i = 0; i < 2 * na; ++i) {
+            // arêtes (v, succ v) et (pred v, v) de chaque ville du bord
+            int a = (i & 1) ? pred[ba[i / 2]] : ba[i / 2], b = succ[a];
+            double dab = distance_ij(inst, a, b);
+            for (int j = 0; j < 2 * nb; ++j) {
+                int c = (j & 1) ? pred[bb[j / 2]] : bb[j / 2], d = succ[c];
+                double base = dab + distance_ij(inst, c, d);
+                double g1 = distance_ij(inst, a, d) + distance_ij(inst, c, b) - base;
+                double g2 = distance_ij(inst, a, c) + distance_ij(inst, d, b) - base;
+                if (ma < 0 || g1 < best) {
+                    best = g1;
+                    ma = a;
+                    mc = c;
+                    inverse = 0;
+                }
+                if (g2 < best) {
+                    best = g2;
+                    ma = a;
+                    mc = c;
+                    inverse = 1;
+                }
+            }
+        }
+
+        int a = ma, b = succ[ma], c = mc, d = succ[mc];
+        if (inverse) {
+            // nouveau cycle parcouru à rebours : (c, d) devient d -> c
+            const int *cyc = dc->idx + B->debut;
+            for (int i = 0; i < B->taille; ++i) {
+                int v = cyc[i], t = succ[v];
+                succ[v] = pred[v];
+                pred[v] = t;
+            }
+            int t = c;
+            c = d;
+            d = t;
+        }
+        // a -> d ... c -> b
+        succ[a] = d;
+        pred[d] = a;
+        succ[c] = b;
+        pred[b] = c;
+        dc->jonctions[2 * (k - 1)] = a;
+        dc->jonctions[2 * (k - 1) + 1] = c;
+    }
+}
+
+/* ---------- réoptimisation des jonctions ---------- */
+
+/* 2-opt et Or-opt sur le chemin w[0..W) à extrémités fixes, distances locales D (W x W,
+ * indices locaux) ; retourne 1 si le chemin a changé */
+static int optimiser_chemin(int *w, int W, const double *D) {
+    int change = 0, ameliore = 1;
+    while (ameliore) {
+        ameliore = 0;
+        // 2-opt : arêtes (i, i+1) et (j, j+1), inversion de w[i+1..j]
+        for (int i = 0; i + 3 < W; ++i)
+            for (int j = i + 2; j + 1 < W; ++j) {
+                int a = w[i], b = w[i + 1], c = w[j], d = w[j + 1];
+                if (D[a * W + c] + D[b * W + d] < D[a * W + b] + D[c * W + d] - 1e-9) {
+                    for (int l = i + 1, r = j; l < r; ++l, --r) {
+                        int tmp = w[l];
+                        w[l] = w[r];
+                        w[r] = tmp;
+                    }
+                    ameliore = change = 1;
+                }
+            }
+        // Or-opt : segment w[s..s+L) déplacé entre w[t] et w[t+1], éventuellement inversé
+        for (int L = 1; L <= DC_OR_MAX; ++L)
+            for (int s = 1; s + L < W; ++s) {
+                int p = w[s - 1], s1 = w[s], s2 = w[s + L - 1], nx = w[s + L];
+                double retrait = D[p * W + s1] + D[s2 * W + nx] - D[p * W + nx];
+                for (int t = 0; t + 1 < W; ++t) {
+                    if (t >= s - 1 && t < s + L) continue;
+                    int a = w[t], b = w[t + 1];
+                    double direct = D[a * W + s1] + D[s2 * W + b];
+                    double inverse = D[a * W + s2] + D[s1 * W + b];
+                    double ajout = (direct <= inverse ? direct : inverse) - D[a * W + b];
+                    if (ajout < retrait - 1e-9) {
+                        int seg[DC_OR_MAX];
+                        for (int q = 0; q < L; ++q)
+                            seg[q] = (direct <= inverse) ? w[s + q] : w[s + L - 1 - q];
+                        // retrait du segment puis insertion après w[t] (indices décalés si t > s)
+                        memmove(w + s, w + s + L, (W - s - L) * sizeof(int));
+                        int ins = (t < s) ? t + 1 : t + 1 - L;
+                        memmove(w + ins + L, w + ins, (W - L - ins) * sizeof(int));
+                        memcpy(w + ins, seg, L * sizeof(int));
+                        ameliore = change = 1;
+                        break;
+                    }
+                }
+            }
+    }
+    return change;
+}
+
+static void reparer_fenetre(void *arg, int k, int worker) {
+    (void)worker;
+    DC *dc = arg;
+    int debut = dc->fenetres[2 * k], W = dc->fenetres[2 * k + 1];
+    int *villes = malloc(W * sizeof(int));
+    int *w = malloc(W * sizeof(int));
+    double *D = malloc((size_t)W * W * sizeof(double));
+    if (villes && w && D) {
+        for (int i = 0; i < W; ++i) {
+            villes[i] = dc->tour[debut + i];
+            w[i] = i;
+        }
+        for (int i = 0; i < W; ++i) {
+            D[i * W + i] = 0.0;
+            for (int j = i + 1; j < W; ++j)
+                D[i * W + j] = D[j * W + i] = distance_ij(dc->inst, villes[i], villes[j]);
+        }
+        if (optimiser_chemin(w, W, D))
+            for (int i = 0; i < W; ++i)
+                dc->tour[debut + i] = villes[w[i]];
+    }
+    free(villes);
+    free(w);
+    free(D);
+}
+
+static int cmp_int(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+/* Fenêtres disjointes [debut, debut + longueur) de la tournée autour des arêtes de
+ * jonction (positions triées) ; deux jonctions proches partagent une fenêtre, de
+ * longueur bornée par DC_FENETRE_MAX. Retourne le nombre de fenêtres. */
+static int fenetres(DC *dc, int *positions, int nb) {
+    int n = dc->inst->dimension, nf = 0, fin = 0;
+    qsort(positions, nb, sizeof(int), cmp_int);
+    for (int j = 0; j < nb; ++j) {
+        // arête (tour[q], tour[q + 1]) au centre de la fenêtre
+        int q = positions[j];
+        int lo = q + 1 - DC_DEMI_FENETRE, hi = q + 1 + DC_DEMI_FENETRE;
+        if (lo < 0) lo = 0;
+        if (hi > n) hi = n;
+        if (nf > 0 && lo < fin && hi - dc->fenetres[2 * (nf - 1)] <= DC_FENETRE_MAX) {
+            dc->fenetres[2 * (nf - 1) + 1] = hi - dc->fenetres[2 * (nf - 1)];
+            fin = hi;
+            continue;
+        }
+        if (lo < fin) lo = fin;
+        if (hi - lo < 4) continue;
+        dc->fenetres[2 * nf] = lo;
+        dc->fenetres[2 * nf + 1] = hi - lo;
+        nf++;
+        fin = hi;
+    }
+    return nf;
+}
+
+int *decompose_solve(const TSP_Instance *inst, const char *methode, const Solver_Params *p,
+                     int taille_cluster, int nb_threads, Solve_Context *ctx) {
+    int n = inst->dimension;
+    if (n <= 0 || !inst->x || !inst->y) return NULL;
+    if (taille_cluster < 4) taille_cluster = 4;
+    if (nb_threads < 1) nb_threads = 1;
+
+    DC dc;
+    memset(&dc, 0, sizeof(dc));
+    dc.inst = inst;
+    dc.methode = methode;
+    dc.params = *p;
+    dc.params.nb_threads = 1;           // le parallélisme est entre clusters
+    dc.params.ga_trace = NULL;
+    dc.params.checkpoint.file = NULL;
+    dc.ctx = ctx;
+    dc.idx = malloc(n * sizeof(int));
+    // partition par moitiés : au plus 2n / taille_cluster + 1 clusters
+    dc.clusters = malloc(((size_t)2 * n / taille_cluster + 2) * sizeof(Cluster));
+    dc.tour = malloc(((size_t)n + 1) * sizeof(int));
+    int *succ = malloc(n * sizeof(int));
+    int *pred = malloc(n * sizeof(int));
+    int *centres = NULL;
+    double *cx = NULL, *cy = NULL;
+    int ok = (dc.idx && dc.clusters && dc.tour && succ && pred);
+
+    if (ok) {
+        for (int i = 0; i < n; ++i)
+            dc.idx[i] = i;
+        double t0 = stats_begin();
+        partitionner(inst, dc.idx, 0, n, taille_cluster, dc.clusters, &dc.nb_clusters);
+        stats_end(STAT_CONSTRUCT, t0);
+        int m = dc.nb_clusters;
+        if (stats_enabled)
+            fprintf(stderr, "[DC] %d clusters de %d villes au plus, %d threads\n", m, taille_cluster, nb_threads);
+
+        pool_run(m, nb_threads, resoudre_cluster, &dc);
+
+        cx = malloc(m * sizeof(double));
+        cy = malloc(m * sizeof(double));
+        dc.jonctions = malloc(2 * (size_t)m * sizeof(int));
+        dc.fenetres = malloc(4 * (size_t)m * sizeof(int));
+        ok = (cx && cy && dc.jonctions && dc.fenetres);
+        if (ok) {
+            for (int c = 0; c < m; ++c) {
+                cx[c] = dc.clusters[c].cx;
+                cy[c] = dc.clusters[c].cy;
+            }
+            centres = hilbert_order(cx, cy, m);
+            ok = (centres != NULL);
+        }
+        if (ok) {
+            double t1 = stats_begin();
+            fusionner(&dc, centres, succ, pred);
+            // tournée à partir de la ville 0 ; pred sert ensuite de position
+            int v = 0;
+            for (int i = 0; i < n; ++i) {
+                dc.tour[i] = v;
+                pred[v] = i;
+                v = succ[v];
+            }
+            dc.tour[n] = dc.tour[0];
+            stats_end(STAT_CONSTRUCT, t1);
+            if (solve_ctx_wants_progress(ctx))
+                solve_ctx_report(ctx, tour_length(inst, dc.tour));
+
+            int nb_jonctions = 2 * (m - 1);
+            for (int j = 0; j < nb_jonctions; ++j)
+                dc.jonctions[j] = pred[dc.jonctions[j]];
+            int nf = fenetres(&dc, dc.jonctions, nb_jonctions);
+            if (nf > 0 && !solve_ctx_stop(ctx)) {
+                double t2 = stats_begin();
+                pool_run(nf, nb_threads, reparer_fenetre, &dc);
+                stats_end(STAT_IMPROVE, t2);
+            }
+        }
+    }
+
+    free(dc.idx);
+    free(dc.clusters);
+    free(dc.jonctions);
+    free(dc.fenetres);
+    free(succ);
+    free(pred);
+    free(centres);
+    free(cx);
+    free(cy);
+    if (!ok) {
+        free(dc.tour);
+        return NULL;
+    }
+    return dc.tour;
+}
@@ -4,6 +4,7 @@
 #include <string.h>
 #include <stdlib.h>
 #include "distance.h"
+#include "stats.h"
 
 // ---------- helpers ----------
 
@@ -65,6 +66,21 @@ static inline int dist_geo_ij(double lati_degmin, double loni_degmin,
     return (int)(RRR * acos(val) + 1.0);
 }
 
+// Distance (i, j) selon le type de l'instance, sans la matrice
+static inline int dist_ij(const TSP_Instance *inst, int i, int j) {
+    switch (inst->dist_type) {
+        case DIST_EUC_2D:
+            return dist_euc2d_ij(inst->x[i], inst->y[i], inst->x[j], inst->y[j]);
+        case DIST_ATT:
+            return dist_att_ij(inst->x[i], inst->y[i], inst->x[j], inst->y[j]);
+        case DIST_GEO:
+            // En GEO, x = latitude, y = longitude telles que fournies par le fichier TSPLIB
+            return dist_geo_ij(inst->x[i], inst->y[i], inst->x[j], inst->y[j]);
+        default:
+            return 0;
+    }
+}
+
 // ---------- API ----------
 
 DistanceType parse_distance_type(const char *s) {
@@ -79,27 +95,20 @@ void build_distance_matrix(TSP_Instance *inst) {
     int n = inst->dimension;
     if (!inst || n <= 0 || !inst->x || !inst->y) return;
 
+    double t0 = stats_begin();
     inst->dist = (double*)malloc((size_t)n * (size_t)n * sizeof(double));
     for (int i = 0; i < n; ++i) {
         inst->dist[i*(size_t)n + i] = 0.0;
         for (int j = i + 1; j < n; ++j) {
-            int dij = 0;
-            switch (inst->dist_type) {
-                case DIST_EUC_2D:
-                    dij = dist_euc2d_ij(inst->x[i], inst->y[i], inst->x[j], inst->y[j]);
-                    break;
-                case DIST_ATT:
-                    dij = dist_att_ij(inst->x[i], inst->y[i], inst->x[j], inst->y[j]);
-                    break;
-                case DIST_GEO:
-                    // En GEO, x = latitude, y = longitude telles que fournies par le fichier TSPLIB
-                    dij = dist_geo_ij(inst->x[i], inst->y[i], inst->x[j], inst->y[j]);
-                    break;
-                default:
-                    dij = 0;
-            }
+            int dij = dist_ij(inst, i, j);
             inst->dist[i*(size_t)n + j] = (double)dij;
             inst->dist[j*(size_t)n + i] = (double)dij; // symétrique
         }
     }
+    stats_end(STAT_MATRIX, t0);
+}
+
+double distance_ij(const TSP_Instance *inst, int i, int j) {
+    if (inst->dist) return inst->dist[i * (size_t)inst->dimension + j];
+    return (i == j) ? 0.0 : (double)dist_ij(inst, i, j);
 }
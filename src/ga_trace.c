@@ -0,0 +1,126 @@
+/* ga_trace.c
+ * Anneau producteur unique / consommateur unique : le GA avance head, l'écrivain
+ * avance tail. L'écrivain se réveille quand l'anneau est à moitié plein, ou au
+ * plus tard toutes les GA_TRACE_PERIODE_MS millisecondes.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "ga_trace.h"
+
+#define GA_TRACE_PERIODE_MS 50
+
+struct GA_Trace {
+    FILE *fp;
+    GA_Trace_Entry *ring;
+    int capacity;
+    atomic_ulong head;          /* prochaine case écrite par le GA */
+    atomic_ulong tail;          /* prochaine case lue par l'écrivain */
+    atomic_int closing;
+    unsigned long dropped;      /* lignes perdues, anneau plein (producteur seul) */
+    pthread_t writer;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+};
+
+static void drain(GA_Trace *t) {
+    unsigned long tail = atomic_load_explicit(&t->tail, memory_order_relaxed);
+    unsigned long head = atomic_load_explicit(&t->head, memory_order_acquire);
+    for (; tail != head; ++tail) {
+        const GA_Trace_Entry *e = &t->ring[tail % t->capacity];
+        fprintf(t->fp, "%d;%.0f;%.2f;%.0f;%.4f;%.6f\n",
+                e->generation, e->best, e->mean, e->worst, e->diversity, e->elapsed);
+    }
+    atomic_store_explicit(&t->tail, tail, memory_order_release);
+}
+
+static void *writer_main(void *arg) {
+    GA_Trace *t = arg;
+    pthread_mutex_lock(&t->lock);
+    while (!atomic_load(&t->closing)) {
+        struct timespec ts;
+        clock_gettime(CLOCK_REALTIME, &ts);
+        ts.tv_nsec += GA_TRACE_PERIODE_MS * 1000000L;
+        if (ts.tv_nsec >= 1000000000L) {
+            ts.tv_sec++;
+            ts.tv_nsec -= 1000000000L;
+        }
+        pthread_cond_timedwait(&t->wake, &t->lock, &ts);
+
+        pthread_mutex_unlock(&t->lock);
+        drain(t);
+        pthread_mutex_lock(&t->lock);
+    }
+    pthread_mutex_unlock(&t->lock);
+    drain(t);
+    return NULL;
+}
+
+GA_Trace *ga_trace_open(const char *filename, int capacity) {
+    GA_Trace *t = calloc(1, sizeof(GA_Trace));
+    if (!t) return NULL;
+    t->capacity = capacity > 0 ? capacity : 1;
+    t->ring = malloc(t->capacity * sizeof(GA_Trace_Entry));
+    t->fp = fopen(filename, "w");
+    if (!t->ring || !t->fp) {
+        if (!t->fp) perror("Erreur ouverture fichier de trace");
+        else fclose(t->fp);
+        free(t->ring);
+        free(t);
+        return NULL;
+    }
+    fprintf(t->fp, "generation;meilleur;moyenne;pire;diversite;temps(s)\n");
+
+    atomic_init(&t->head, 0);
+    atomic_init(&t->tail, 0);
+    atomic_init(&t->closing, 0);
+    pthread_mutex_init(&t->lock, NULL);
+    pthread_cond_init(&t->wake, NULL);
+    if (pthread_create(&t->writer, NULL, writer_main, t) != 0) {
+        pthread_cond_destroy(&t->wake);
+        pthread_mutex_destroy(&t->lock);
+        fclose(t->fp);
+        free(t->ring);
+        free(t);
+        return NULL;
+    }
+    return t;
+}
+
+void ga_trace_push(GA_Trace *t, const GA_Trace_Entry *e) {
+    if (!t) return;
+    unsigned long head = atomic_load_explicit(&t->head, memory_order_relaxed);
+    unsigned long used = head - atomic_load_explicit(&t->tail, memory_order_acquire);
+    if (used >= (unsigned long)t->capacity) {
+        t->dropped++;
+        return;
+    }
+    t->ring[head % t->capacity] = *e;
+    atomic_store_explicit(&t->head, head + 1, memory_order_release);
+
+    // à moitié plein : réveil anticipé de l'écrivain, sans attendre le verrou
+    if (used + 1 == (unsigned long)(t->capacity + 1) / 2 && pthread_mutex_trylock(&t->lock) == 0) {
+        pthread_cond_signal(&t->wake);
+        pthread_mutex_unlock(&t->lock);
+    }
+}
+
+void ga_trace_close(GA_Trace *t) {
+    if (!t) return;
+    pthread_mutex_lock(&t->lock);
+    atomic_store(&t->closing, 1);
+    pthread_cond_signal(&t->wake);
+    pthread_mutex_unlock(&t->lock);
+    pthread_join(t->writer, NULL);
+
+    if (t->dropped)
+        fprintf(stderr, "[GA] trace : %lu générations perdues (anneau plein)\n", t->dropped);
+    fclose(t->fp);
+    pthread_cond_destroy(&t->wake);
+    pthread_mutex_destroy(&t->lock);
+    free(t->ring);
+    free(t);
+}
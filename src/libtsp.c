@@ -0,0 +1,222 @@
+/* libtsp.c
+ * Implémentation de l'API C de libtsp.so (voir include/libtsp.h) : fine couche
+ * au-dessus du parseur, de solver_run et de l'export CSV, sans état global.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "libtsp.h"
+#include "tsp_parser.h"
+#include "distance.h"
+#include "algo_nn.h"
+#include "csv_export.h"
+#include "solver.h"
+#include "solve_ctx.h"
+#include "tour_io.h"
+
+#define LIBTSP_PARAMS_MAX 1024      // longueur maximale de la chaîne de paramètres
+
+struct LibTSP_Instance {
+    TSP_Instance *inst;
+};
+
+struct LibTSP_Control {
+    Solve_Context ctx;
+    double budget;          // durée maximale de chaque résolution
+    int stopped;            // dernière résolution écourtée
+};
+
+int libtsp_version(void) {
+    return LIBTSP_VERSION;
+}
+
+const char *libtsp_strerror(int code) {
+    switch (code) {
+    case LIBTSP_OK:          return "succès";
+    case LIBTSP_ERR_ARG:     return "argument invalide";
+    case LIBTSP_ERR_METHOD:  return "méthode inconnue";
+    case LIBTSP_ERR_PARAM:   return "paramètre inconnu ou manquant";
+    case LIBTSP_ERR_SOLVE:   return "échec de la résolution";
+    case LIBTSP_ERR_IO:      return "erreur d'entrée/sortie";
+    default:                 return "code inconnu";
+    }
+}
+
+static LibTSP_Instance *envelopper(TSP_Instance *inst) {
+    if (!inst) return NULL;
+    LibTSP_Instance *h = malloc(sizeof(LibTSP_Instance));
+    if (!h) {
+        tsp_free_instance(inst);
+        return NULL;
+    }
+    h->inst = inst;
+    return h;
+}
+
+LibTSP_Instance *libtsp_load(const char *filename) {
+    if (!filename) return NULL;
+    return envelopper(tsp_read_file(filename));
+}
+
+LibTSP_Instance *libtsp_from_coords(int n, const double *x, const double *y, long stride,
+                                    const char *dist_type) {
+    if (n <= 0 || !x || !y || stride < 1) return NULL;
+    DistanceType dt = dist_type ? parse_distance_type(dist_type) : DIST_EUC_2D;
+    if (dt == DIST_UNKNOWN) return NULL;
+    if (stride == 1)
+        return envelopper(tsp_from_coords("libtsp", dt, n, x, y));
+
+    // coordonnées entrelacées : regroupées colonne par colonne (O(n), la matrice est en O(n²))
+    double *cx = malloc((size_t)n * sizeof(double));
+    double *cy = malloc((size_t)n * sizeof(double));
+    LibTSP_Instance *h = NULL;
+    if (cx && cy) {
+        for (int i = 0; i < n; ++i) {
+            cx[i] = x[(size_t)i * stride];
+            cy[i] = y[(size_t)i * stride];
+        }
+        h = envelopper(tsp_from_coords("libtsp", dt, n, cx, cy));
+    }
+    free(cx);
+    free(cy);
+    return h;
+}
+
+void libtsp_free(LibTSP_Instance *inst) {
+    if (!inst) return;
+    tsp_free_instance(inst->inst);
+    free(inst);
+}
+
+int libtsp_dimension(const LibTSP_Instance *inst) {
+    return inst ? inst->inst->dimension : 0;
+}
+
+double libtsp_distance(const LibTSP_Instance *inst, int i, int j) {
+    if (!inst) return -1.0;
+    int n = inst->inst->dimension;
+    if (i < 0 || j < 0 || i >= n || j >= n) return -1.0;
+    return inst->inst->dist[i * n + j];
+}
+
+int libtsp_is_method(const char *method) {
+    return method && solver_is_method(method);
+}
+
+// "clé=valeur clé=valeur" -> p ; 0 si une clé est inconnue ou mal formée
+static int lire_params(Solver_Params *p, const char *params, int *pop_gen_mut) {
+    *pop_gen_mut = 0;
+    if (!params) return 1;
+    char buf[LIBTSP_PARAMS_MAX];
+    if (strlen(params) >= sizeof(buf)) return 0;
+    strcpy(buf, params);
+
+    char *reste = NULL;
+    for (char *t = strtok_r(buf, " \t\r\n", &reste); t; t = strtok_r(NULL, " \t\r\n", &reste)) {
+        char *eq = strchr(t, '=');
+        if (!eq) return 0;
+        *eq = '\0';
+        if (!solver_set_param(p, t, eq + 1)) return 0;
+        if (!strcmp(t, "pop") || !strcmp(t, "gen") || !strcmp(t, "mut"))
+            (*pop_gen_mut)++;
+    }
+    return 1;
+}
+
+LibTSP_Control *libtsp_control_new(double deadline_sec, LibTSP_Progress progress, void *user) {
+    LibTSP_Control *ctl = malloc(sizeof(LibTSP_Control));
+    if (!ctl) return NULL;
+    solve_ctx_init(&ctl->ctx, deadline_sec, progress, user);
+    ctl->budget = deadline_sec;
+    ctl->stopped = 0;
+    return ctl;
+}
+
+void libtsp_control_cancel(LibTSP_Control *ctl) {
+    if (ctl) solve_ctx_cancel(&ctl->ctx);
+}
+
+int libtsp_control_stopped(const LibTSP_Control *ctl) {
+    return ctl ? ctl->stopped : 0;
+}
+
+void libtsp_control_free(LibTSP_Control *ctl) {
+    if (!ctl) return;
+    solve_ctx_destroy(&ctl->ctx);
+    free(ctl);
+}
+
+int libtsp_solve(const LibTSP_Instance *inst, const char *method, const char *params,
+                 int *tour, double *length) {
+    return libtsp_solve_ctl(inst, method, params, tour, length, NULL);
+}
+
+int libtsp_solve_ctl(const LibTSP_Instance *inst, const char *method, const char *params,
+                     int *tour, double *length, LibTSP_Control *ctl) {
+    if (!inst || !method || !tour) return LIBTSP_ERR_ARG;
+    if (!solver_is_method(method)) return LIBTSP_ERR_METHOD;
+
+    Solver_Params p;
+    solver_default_params(&p);
+    int pop_gen_mut;
+    if (!lire_params(&p, params, &pop_gen_mut)) return LIBTSP_ERR_PARAM;
+    if (solver_needs_ga_params(method) && pop_gen_mut < 3) return LIBTSP_ERR_PARAM;
+    p.ga_trace = NULL;      // pas de fichier écrit dans le dos de l'appelant
+
+    const TSP_Instance *ti = inst->inst;
+    Solve_Context *ctx = NULL;
+    if (ctl) {
+        solve_ctx_restart(&ctl->ctx, ctl->budget);
+        ctx = &ctl->ctx;
+    }
+    int *t = solver_run(method, ti, &p, ctx);
+    if (ctl) ctl->stopped = solve_ctx_stop(ctx);
+    if (!t) return LIBTSP_ERR_SOLVE;
+    memcpy(tour, t, (size_t)ti->dimension * sizeof(int));
+    if (length) *length = tour_length(ti, t);
+    free(t);
+    return LIBTSP_OK;
+}
+
+double libtsp_tour_length(const LibTSP_Instance *inst, const int *tour, int n) {
+    if (!inst || !tour || n != inst->inst->dimension) return -1.0;
+    const double *d = inst->inst->dist;
+    char *vu = calloc((size_t)n, 1);
+    if (!vu) return -1.0;
+    double len = 0.0;
+    for (int i = 0; i < n; ++i) {
+        int v = tour[i];
+        if (v < 0 || v >= n || vu[v]) {
+            free(vu);
+            return -1.0;
+        }
+        vu[v] = 1;
+        len += d[v * n + tour[(i + 1) % n]];
+    }
+    free(vu);
+    return len;
+}
+
+int libtsp_export_tour(const char *filename, const LibTSP_Instance *inst, const int *tour) {
+    if (!filename || !inst || !tour) return LIBTSP_ERR_ARG;
+    int n = inst->inst->dimension;
+    if (libtsp_tour_length(inst, tour, n) < 0) return LIBTSP_ERR_ARG;
+    return export_tour(filename, inst->inst->name, NULL, tour, n) == 0 ? LIBTSP_OK : LIBTSP_ERR_IO;
+}
+
+int libtsp_export_csv(const char *filename, const LibTSP_Instance *inst, const char *method,
+                      double duration_sec, const int *tour, int entete) {
+    if (!filename || !inst || !method || !tour) return LIBTSP_ERR_ARG;
+    int n = inst->inst->dimension;
+    double len = libtsp_tour_length(inst, tour, n);
+    if (len < 0) return LIBTSP_ERR_ARG;
+
+    // export_summary_csv attend la tournée fermée (n + 1 villes)
+    int *ferme = malloc(((size_t)n + 1) * sizeof(int));
+    if (!ferme) return LIBTSP_ERR_SOLVE;
+    memcpy(ferme, tour, (size_t)n * sizeof(int));
+    ferme[n] = tour[0];
+    int r = export_summary_csv(filename, inst->inst->name, method, duration_sec, len, 0.0, ferme, n, entete);
+    free(ferme);
+    return r == 0 ? LIBTSP_OK : LIBTSP_ERR_IO;
+}
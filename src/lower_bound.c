@@ -0,0 +1,146 @@
+/* lower_bound.c
+ * Borne inférieure de Held-Karp pour le TSP symétrique.
+ * 1-arbre : arbre couvrant minimal des villes 1..n-1 (Prim sur la matrice, O(n²))
+ * plus les deux arêtes les moins chères de la ville 0. Avec des pénalités pi sur
+ * les nœuds (coût c(i,j) + pi[i] + pi[j]), L(pi) = 1-arbre - 2 * somme(pi) reste un
+ * minorant de toute tournée ; pi est ajusté par sous-gradient (deg - 2) avec le pas
+ * de Polyak lambda * (UB - L) / ||g||².
+ */
+
+#include <stdlib.h>
+#include <math.h>
+#include "lower_bound.h"
+#include "algo_nn.h"
+#include "stats.h"
+
+#define LB_BUDGET_OPERATIONS 1e8   /* plus proche voisin + itérations, n² accès chacun */
+#define LB_ITER_MAX          1000
+#define LB_PATIENCE          10    /* itérations sans progrès avant de diviser lambda */
+
+/* Coût du 1-arbre minimal pour les pénalités pi ; deg reçoit les degrés */
+static double one_tree(const TSP_Instance *inst, const double *pi, int *deg,
+                       double *key, int *parent, char *in_tree) {
+    int n = inst->dimension;
+    double total = 0.0;
+
+    for (int v = 0; v < n; ++v) {
+        key[v] = INFINITY;
+        parent[v] = -1;
+        in_tree[v] = 0;
+        deg[v] = 0;
+    }
+
+    // Prim sur les villes 1..n-1
+    key[1] = 0.0;
+    for (int it = 1; it < n; ++it) {
+        int u = -1;
+        for (int v = 1; v < n; ++v)
+            if (!in_tree[v] && (u < 0 || key[v] < key[u]))
+                u = v;
+
+        in_tree[u] = 1;
+        total += key[u];
+        if (parent[u] >= 0) {
+            deg[u]++;
+            deg[parent[u]]++;
+        }
+
+        const double *row = inst->dist + (size_t)u * n;
+        for (int v = 1; v < n; ++v) {
+            if (in_tree[v]) continue;
+            double c = row[v] + pi[u] + pi[v];
+            if (c < key[v]) {
+                key[v] = c;
+                parent[v] = u;
+            }
+        }
+    }
+
+    // Les deux arêtes les moins chères de la ville 0
+    int a = -1, b = -1;
+    double ca = INFINITY, cb = INFINITY;
+    for (int v = 1; v < n; ++v) {
+        double c = inst->dist[v] + pi[0] + pi[v];
+        if (c < ca) { cb = ca; b = a; ca = c; a = v; }
+        else if (c < cb) { cb = c; b = v; }
+    }
+    total += ca + cb;
+    deg[0] = 2;
+    deg[a]++;
+    deg[b]++;
+
+    double sum_pi = 0.0;
+    for (int v = 0; v < n; ++v)
+        sum_pi += pi[v];
+
+    return total - 2.0 * sum_pi;
+}
+
+double held_karp_bound(const TSP_Instance *inst, Solve_Context *ctx) {
+    int n = inst->dimension;
+    if (n <= 1 || !inst->dist) return 0.0;
+    if (n == 2) return 2.0 * inst->dist[1];
+
+    // une passe O(n²) pour le plus proche voisin, le reste pour les 1-arbres
+    double budget = LB_BUDGET_OPERATIONS / ((double)n * n) - 1.0;
+    if (budget < 1.0 || solve_ctx_stop(ctx)) return 0.0;
+    int iterations = (budget > LB_ITER_MAX) ? LB_ITER_MAX : (int)budget;
+
+    double t0 = stats_begin();
+    int *tour = nn_tour(inst, NULL);
+    if (!tour) return 0.0;
+    double upper_bound = tour_length(inst, tour);
+    free(tour);
+
+    double *pi = calloc(n, sizeof(double));
+    int *deg = malloc(n * sizeof(int));
+    double *key = malloc(n * sizeof(double));
+    int *parent = malloc(n * sizeof(int));
+    char *in_tree = malloc(n);
+    if (!pi || !deg || !key || !parent || !in_tree) {
+        free(pi); free(deg); free(key); free(parent); free(in_tree);
+        return 0.0;
+    }
+
+    double best = -INFINITY;
+    double lambda = 2.0;
+    int stall = 0;
+
+    for (int it = 0; it < iterations && lambda > 1e-6 && !solve_ctx_stop(ctx); ++it) {
+        double L = one_tree(inst, pi, deg, key, parent, in_tree);
+
+        if (L > best) {
+            best = L;
+            stall = 0;
+        } else if (++stall >= LB_PATIENCE) {
+            lambda *= 0.5;
+            stall = 0;
+        }
+
+        double norm = 0.0;
+        for (int v = 0; v < n; ++v)
+            norm += (double)(deg[v] - 2) * (deg[v] - 2);
+        if (norm == 0.0)        // le 1-arbre est une tournée : borne optimale
+            break;
+        if (best >= upper_bound)
+            break;
+
+        double t = lambda * (upper_bound - L) / norm;
+        for (int v = 0; v < n; ++v)
+            pi[v] += t * (deg[v] - 2);
+    }
+
+    free(pi);
+    free(deg);
+    free(key);
+    free(parent);
+    free(in_tree);
+    stats_end(STAT_BOUND, t0);
+
+    // Distances TSPLIB entières : toute tournée a une longueur entière
+    return (best > 0.0) ? ceil(best - 1e-7) : 0.0;
+}
+
+double optimality_gap(double length, double lb) {
+    return (lb > 0.0) ? (length - lb) / lb : 0.0;
+}
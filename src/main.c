@@ -1,26 +1,32 @@
-// Compilation : gcc src/*.c -Iinclude -o bin/tsp.exe -lm
+// Compilation : gcc src/*.c -Iinclude -o bin/tsp.exe -lm -pthread
 // Execution exemple : ./tsp.exe -f tests/data/att15.tsp -m nn
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
 #include <signal.h>
+#include <unistd.h>
 
 #include "tsp_types.h" 
 #include "distance.h"
 #include "tsp_parser.h"
 #include "algo_nn.h"
-#include "algo_bf.h"
-#include "algo_rw.h"
-#include "algo_2opt.h"
 #include "algo_ga.h"
 #include "csv_export.h"
-
-// Variable globale pour la fonction coût
-TSP_Instance *global_inst = NULL;
-
-// Flag interruption Ctrl-C
-volatile sig_atomic_t stop_requested = 0;
+#include "lower_bound.h"
+#include "thread_pool.h"
+#include "solver.h"
+#include "batch.h"
+#include "bench.h"
+#include "stats.h"
+#include "server.h"
+#include "tour_io.h"
+#include "renumber.h"
+#include "decompose.h"
+#include "algo_gpx.h"
+
+// Flag interruption Ctrl-C (défini dans solver.c, partagé avec libtsp)
+extern volatile sig_atomic_t stop_requested;
 
 // Handler Ctrl-C
 void interrupt_handler(int sig) {
@@ -28,24 +34,107 @@ void interrupt_handler(int sig) {
     stop_requested = 1;
 }
 
-// Fonction de coût BF
-void *tsp_cost(void *unused, int *perm) {
-    (void)unused;
-    int n = global_inst->dimension;
-    unsigned long long *cost = malloc(sizeof(unsigned long long));
-    if (!cost) return NULL;
+// -m all : méthodes (solver_all_methodes) exécutées comme tâches indépendantes sur un pool de threads
+
+typedef struct {
+    const TSP_Instance *inst;       // partagée en lecture seule
+    Solver_Params params;
+    Solve_Context *ctx;             // échéance commune à toutes les méthodes
+    int *tours[SOLVER_ALL_NB];
+    double wall[SOLVER_ALL_NB];     // temps réel (CLOCK_MONOTONIC)
+    double cpu[SOLVER_ALL_NB];      // temps CPU du thread ayant exécuté la méthode
+} All_Context;
+
+static void all_task(void *arg, int idx, int worker) {
+    (void)worker;
+    All_Context *c = arg;
+    double wall0 = wall_seconds(), cpu0 = thread_cpu_seconds();
+
+    c->tours[idx] = solver_run(solver_all_methodes[idx], c->inst, &c->params, c->ctx);
+    c->wall[idx] = wall_seconds() - wall0;
+    c->cpu[idx] = thread_cpu_seconds() - cpu0;
+}
+
+// -progress : chaque amélioration de la meilleure tournée sur stderr
+static void show_progress(void *user, double best_length, double elapsed) {
+    (void)user;
+    fprintf(stderr, "[progression] %.3fs longueur %.0f\n", elapsed, best_length);
+}
+
+// Ligne "Tournée : ..." en une seule écriture (le tampon de printf est vidé avant)
+static void print_tour(const int *tour, int n) {
+    Tour_Buffer b;
+    tour_buf_init(&b);
+    tour_buf_str(&b, "Tournée : ");
+    tour_buf_cities(&b, tour, n, ' ', 1);
+    tour_buf_str(&b, "\n");
+    fflush(stdout);
+    tour_buf_write_fd(&b, STDOUT_FILENO);
+    tour_buf_free(&b);
+}
 
-    *cost = 0;
-    for (int i = 0; i < n - 1; ++i)
-        *cost += (unsigned long long)(global_inst->dist[perm[i] * n + perm[i + 1]]);
-    *cost += (unsigned long long)(global_inst->dist[perm[n - 1] * n + perm[0]]);
+// --merge : tournées binaires (liste séparée par des virgules) fusionnées par GPX ;
+// les fichiers illisibles ou d'une autre dimension sont ignorés
+static int *merge_tour_files(const TSP_Instance *inst, const char *liste) {
+    char *copie = strdup(liste);
+    int nb = 0, cap = 8;
+    int **tours = malloc(cap * sizeof(int *));
+    char *reste = NULL;
+    for (char *f = copie ? strtok_r(copie, ",", &reste) : NULL; f && tours; f = strtok_r(NULL, ",", &reste)) {
+        int n = 0;
+        int *t = import_tour_bin(f, &n);
+        if (!t || n != inst->dimension) {
+            fprintf(stderr, "--merge : %s ignoré (%s)\n", f, t ? "autre dimension" : "tournée .bin illisible");
+            free(t);
+            continue;
+        }
+        if (nb == cap) {
+            int **plus = realloc(tours, 2 * cap * sizeof(int *));
+            if (!plus) {
+                free(t);
+                break;
+            }
+            tours = plus;
+            cap *= 2;
+        }
+        tours[nb++] = t;
+    }
+    int *tour = (nb > 0) ? gpx_merge(inst, (const int *const *)tours, nb) : NULL;
+    if (tour) {
+        if (stats_enabled) fprintf(stderr, "[GPX] %d tournées fusionnées\n", nb);
+    } else {
+        fprintf(stderr, "--merge : aucune tournée fusionnée\n");
+    }
+    for (int i = 0; i < nb; ++i)
+        free(tours[i]);
+    free(tours);
+    free(copie);
+    return tour;
+}
 
-    return cost;
+// --stats : résumé sur stderr et export JSON éventuel, quel que soit le mode
+static void report_stats(const char *json_file) {
+    if (!stats_enabled) return;
+    stats_print(stderr);
+    if (json_file) stats_export_json(json_file);
 }
 
 void usage(const char *prog) {
-    fprintf(stderr, "Usage : %s -f <fichier.tsp> -m <all|nn|bf|rw|nn2opt|rw2opt|ga|gadpx> "
-           "[ga|gadpx|all: pop gen mut] [-o <export.csv>]\n", prog);
+    fprintf(stderr, "Usage : %s (-f <fichier.tsp> | -b <jobs.txt> [-mem <Mo>]) -m <all|nn|nnms|nnms2opt|bf|bfenum|hk|rw|nn2opt|rw2opt|ga|gadpx|gaeax|gagpx|sa|acs|acs2opt> "
+           "[ga|gadpx|gaeax|gagpx|all: pop gen mut] [-mt <swap|inv|ins>] [-t <threads, 0 = tous les coeurs ; all : défaut tous>] "
+           "[-ns <départs nnms, 0 = tous>] [-k <tournées nnms2opt passées au 2-opt>] "
+           "[-s <tirages rw|rw2opt>] [-tl <budget rw|rw2opt|sa|acs en secondes>] [-seed <graine>] [-o <export.csv>]\n"
+           "[-dl <échéance en secondes>] [-progress] [-notour] [-nolb] [-ot <tournée.tour|.csv|.bin>] "
+           "[--stats] [--stats-json <stats.json>] [-gt <trace_ga.csv>] [-gs <générations sans amélioration>]\n"
+           "[-cp <sauvegarde> [-cpi <secondes entre sauvegardes>] [--resume]] (ga, gadpx, gaeax, gagpx, bf, bfenum) "
+           "[-hilbert] [-dc <villes par cluster, décomposition géométrique>]\n"
+           "Fusion : %s -f <fichier.tsp> --merge <t1.bin,t2.bin,...> [-ot <tournée>] (GPX des tournées exportées par -ot)\n"
+           "Batch : chaque ligne de jobs.txt est \"<fichier.tsp> <méthode> [pop gen mut]\" ; "
+           "-t threads (défaut : tous les coeurs), -mem plafond mémoire des instances chargées\n"
+           "Bench : %s --bench [-r <répétitions>] [-w <échauffements>] [-seed <graine>] [-bm <m1,m2,...>] "
+           "[-bga <pop> <gen> <mut>] [-bf <fichier.tsp|répertoire>]... [-o <bench.csv>] [-json <bench.json>]\n"
+           "Démon : %s --serve <socket> [-t <workers>] [-cache <instances>] (protocole : voir server.h)\n",
+           prog, prog, prog, prog);
 }
 
 // Fonction de test des distances. 
@@ -109,186 +198,385 @@ int main(int argc, char **argv) {
     const char *methode = NULL;
     const char *csv_file = NULL;
 
-    // paramètres GA
-    int pop_size;
-    int generations;
-    double mut_rate;
+    const char *jobs_file = NULL;
+    const char *stats_json = NULL;
+    const char *socket_path = NULL;
+    int cache_capacity = SERVE_CACHE_DEFAUT;
+
+    // mode --bench
+    int bench = 0;
+    const char *bench_corpus[64];
+    Bench_Options bench_opt = { BENCH_REPETITIONS, 1, 0, BENCH_METHODES, bench_corpus, 0, NULL, NULL };
+    double mem_mo = BATCH_MEM_DEFAUT_MO;
+
+    // paramètres des méthodes (GA, threads, nnms, rw)
+    Solver_Params params;
+    solver_default_params(&params);
+    int threads_set = 0;
+    double deadline = 0.0;      // -dl : résolution arrêtée après ce délai (meilleure tournée rendue)
+    int progress = 0;
+    int show_tour = 1;              // -notour : pas de liste des villes sur stdout
+    int borne = 1;                  // -nolb : pas de borne de Held-Karp après la résolution
+    const char *tour_file = NULL;   // -ot : tournée exportée (format selon l'extension)
+    int hilbert = 0;                // -hilbert : villes renumérotées le long d'une courbe de Hilbert
+    int dc_taille = 0;              // -dc : décomposition en clusters (0 : résolution globale)
+    const char *merge_files = NULL; // --merge : tournées à fusionner au lieu de résoudre
 
     // is all ?
     int all = 0;
-    int ** tours;
-    double * elapses;
-    double * lengths;
+    All_Context all_ctx;
+    double lengths[SOLVER_ALL_NB];
 
     // Lecture arguments
     for (int i = 1; i < argc; ++i) {
         if (!strcmp(argv[i], "-f") && i + 1 < argc)
             fichier = argv[++i];
 
+        else if (!strcmp(argv[i], "--stats"))
+            stats_enabled = 1;
+
+        else if (!strcmp(argv[i], "--stats-json") && i + 1 < argc) {
+            stats_enabled = 1;
+            stats_json = argv[++i];
+        }
+
+        else if (!strcmp(argv[i], "--serve") && i + 1 < argc)
+            socket_path = argv[++i];
+
+        else if (!strcmp(argv[i], "-cache") && i + 1 < argc)
+            cache_capacity = atoi(argv[++i]);
+
+        else if (!strcmp(argv[i], "--bench"))
+            bench = 1;
+
+        else if (!strcmp(argv[i], "-r") && i + 1 < argc)
+            bench_opt.repetitions = atoi(argv[++i]);
+
+        else if (!strcmp(argv[i], "-w") && i + 1 < argc)
+            bench_opt.warmup = atoi(argv[++i]);
+
+        else if (!strcmp(argv[i], "-bm") && i + 1 < argc)
+            bench_opt.methodes = argv[++i];
+
+        else if (!strcmp(argv[i], "-bf") && i + 1 < argc) {
+            if (bench_opt.nb_corpus < 64) bench_corpus[bench_opt.nb_corpus++] = argv[i + 1];
+            i++;
+        }
+
+        else if (!strcmp(argv[i], "-bga") && i + 3 < argc) {
+            params.pop_size = atoi(argv[++i]);
+            params.generations = atoi(argv[++i]);
+            params.mut_rate = atof(argv[++i]);
+        }
+
+        else if (!strcmp(argv[i], "-json") && i + 1 < argc)
+            bench_opt.json_file = argv[++i];
+
+        else if (!strcmp(argv[i], "-gt") && i + 1 < argc)
+            params.ga_trace = argv[++i];
+
+        else if (!strcmp(argv[i], "-gs") && i + 1 < argc)
+            params.ga_stagnation = atoi(argv[++i]);
+
+        else if (!strcmp(argv[i], "-seed") && i + 1 < argc)
+            params.seed = (unsigned int)strtoul(argv[++i], NULL, 10);
+
+        else if (!strcmp(argv[i], "-b") && i + 1 < argc)
+            jobs_file = argv[++i];
+
+        else if (!strcmp(argv[i], "-mem") && i + 1 < argc)
+            mem_mo = atof(argv[++i]);
+
         else if (!strcmp(argv[i], "-m") && i + 1 < argc) {
             methode = argv[++i];
-            if (!strcmp(methode, "ga") || !strcmp(methode, "gadpx") || !strcmp(methode, "all")) {
+            if (solver_needs_ga_params(methode)) {
                 if (argc < i + 4) {
                     if (!strcmp(methode, "all")) fprintf(stderr, "La méthode ALL demande les paramètres du GA.\n");
                     fprintf(stderr, "Usage GA : -m %s <pop> <gen> <mut>\n", methode);
                     return 1;
                 }
-                pop_size = atoi(argv[++i]);
-                generations = atoi(argv[++i]);
-                mut_rate = atof(argv[++i]);
+                params.pop_size = atoi(argv[++i]);
+                params.generations = atoi(argv[++i]);
+                params.mut_rate = atof(argv[++i]);
+            }
+        }
+
+        else if (!strcmp(argv[i], "-mt") && i + 1 < argc) {
+            const char *mt = argv[++i];
+            if (!strcmp(mt, "swap")) params.mutation = GA_MUT_SWAP;
+            else if (!strcmp(mt, "inv")) params.mutation = GA_MUT_INVERSION;
+            else if (!strcmp(mt, "ins")) params.mutation = GA_MUT_INSERTION;
+            else {
+                fprintf(stderr, "Mutation inconnue : %s\n", mt);
+                return 1;
             }
         }
 
+        else if (!strcmp(argv[i], "-t") && i + 1 < argc) {
+            params.nb_threads = atoi(argv[++i]);
+            threads_set = 1;
+            if (params.nb_threads <= 0) params.nb_threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+            if (params.nb_threads <= 0) params.nb_threads = 1;
+        }
+
+        else if (!strcmp(argv[i], "-ns") && i + 1 < argc)
+            params.nn_departs = atoi(argv[++i]);
+
+        else if (!strcmp(argv[i], "-k") && i + 1 < argc) {
+            params.nn_top_k = atoi(argv[++i]);
+            if (params.nn_top_k < 1) params.nn_top_k = 1;
+        }
+
+        else if (!strcmp(argv[i], "-s") && i + 1 < argc)
+            params.rw_samples = atoll(argv[++i]);
+
+        else if (!strcmp(argv[i], "-tl") && i + 1 < argc)
+            params.rw_budget = atof(argv[++i]);
+
         else if (!strcmp(argv[i], "-o") && i + 1 < argc)
             csv_file = argv[++i];
 
+        else if (!strcmp(argv[i], "-dl") && i + 1 < argc)
+            deadline = atof(argv[++i]);
+
+        else if (!strcmp(argv[i], "-progress"))
+            progress = 1;
+
+        else if (!strcmp(argv[i], "-notour"))
+            show_tour = 0;
+
+        else if (!strcmp(argv[i], "-nolb"))
+            borne = 0;
+
+        else if (!strcmp(argv[i], "-ot") && i + 1 < argc)
+            tour_file = argv[++i];
+
+        else if (!strcmp(argv[i], "-cp") && i + 1 < argc)
+            params.checkpoint.file = argv[++i];
+
+        else if (!strcmp(argv[i], "-cpi") && i + 1 < argc)
+            params.checkpoint.periode = atof(argv[++i]);
+
+        else if (!strcmp(argv[i], "--resume"))
+            params.checkpoint.reprise = 1;
+
+        else if (!strcmp(argv[i], "-hilbert"))
+            hilbert = 1;
+
+        else if (!strcmp(argv[i], "--merge") && i + 1 < argc) {
+            merge_files = argv[++i];
+            methode = "merge";
+        }
+
+        else if (!strcmp(argv[i], "-dc") && i + 1 < argc) {
+            dc_taille = atoi(argv[++i]);
+            if (dc_taille <= 0) dc_taille = DC_TAILLE_DEFAUT;
+        }
+
         else if (!strcmp(argv[i], "-h")) {
             usage(argv[0]);
             return 0;
         }
     }
 
+    // Installation du handler Ctrl-C
+    signal(SIGINT, interrupt_handler);
+
+    // Sauvegarde : une seule résolution à la fois écrit dans le fichier (pas en démon,
+    // bench, batch ni -m all)
+    if (params.checkpoint.reprise && !params.checkpoint.file)
+        fprintf(stderr, "--resume sans -cp <sauvegarde> : ignoré\n");
+    if (params.checkpoint.file && (socket_path || bench || jobs_file || (methode && !strcmp(methode, "all")))) {
+        fprintf(stderr, "-cp : sauvegarde limitée à une seule méthode (-f ... -m <méthode>), ignorée\n");
+        params.checkpoint.file = NULL;
+    }
+
+    // Mode démon : requêtes servies sur une socket Unix jusqu'à Ctrl-C
+    if (socket_path) {
+        int nb_workers = threads_set ? params.nb_threads : (int)sysconf(_SC_NPROCESSORS_ONLN);
+        params.nb_threads = 1;  // par requête : clé threads=
+        params.ga_trace = NULL;
+        int rc = serve(socket_path, &params, nb_workers, cache_capacity);
+        report_stats(stats_json);
+        return rc;
+    }
+
+    // Mode bench : chaque méthode est répétée sur tout le corpus
+    if (bench) {
+        if (bench_opt.nb_corpus == 0) bench_corpus[bench_opt.nb_corpus++] = BENCH_CORPUS;
+        if (bench_opt.repetitions < 1) bench_opt.repetitions = 1;
+        if (bench_opt.warmup < 0) bench_opt.warmup = 0;
+        bench_opt.seed = params.seed ? params.seed : 1;
+        bench_opt.csv_file = csv_file;
+        if (params.pop_size <= 0) {
+            params.pop_size = BENCH_GA_POP;
+            params.generations = BENCH_GA_GEN;
+            params.mut_rate = BENCH_GA_MUT;
+        }
+        int rc = bench_run(&bench_opt, &params);
+        report_stats(stats_json);
+        return rc;
+    }
+
+    // Mode batch : les instances et méthodes viennent du fichier de jobs
+    if (jobs_file) {
+        int nb_workers = threads_set ? params.nb_threads : (int)sysconf(_SC_NPROCESSORS_ONLN);
+        params.nb_threads = 1;  // le parallélisme est entre jobs
+        params.ga_trace = NULL; // un seul fichier de trace pour des GA concurrents : désactivée
+        int ok = batch_run(jobs_file, csv_file, &params, nb_workers, mem_mo * 1024.0 * 1024.0, borne);
+        report_stats(stats_json);
+        return ok ? 0 : 4;
+    }
+
     if (!fichier || !methode) {
         usage(argv[0]);
         return 1;
     }
 
-    // Installation du handler Ctrl-C
-    signal(SIGINT, interrupt_handler);
+    if (merge_files && (hilbert || dc_taille > 0)) {
+        fprintf(stderr, "--merge : tournées dans la numérotation du fichier, -hilbert et -dc ignorés\n");
+        hilbert = 0;
+        dc_taille = 0;
+    }
+    if (dc_taille > 0 && !strcmp(methode, "all")) {
+        fprintf(stderr, "-dc : une seule méthode par cluster, -m all non pris en charge\n");
+        return 1;
+    }
 
-    // Lecture instance
-    TSP_Instance *inst = tsp_read_file(fichier);
+    // Lecture instance ; -hilbert : renumérotation avant le calcul de la matrice ;
+    // -dc : pas de matrice globale (seuls les clusters en ont une)
+    TSP_Instance *inst = (hilbert || dc_taille > 0) ? tsp_read_coords(fichier) : tsp_read_file(fichier);
     if (!inst) {
         fprintf(stderr, "Erreur lecture fichier.\n");
         return 2;
     }
-
-    global_inst = inst;
+    int *ordre = NULL;      // nouvel indice -> identifiant d'origine
+    if (hilbert) {
+        ordre = tsp_renumber_hilbert(inst);
+        if (!ordre) fprintf(stderr, "-hilbert : renumérotation impossible, ordre du fichier conservé\n");
+        if (dc_taille <= 0) build_distance_matrix(inst);
+    }
 
     int *tour = NULL;
     double length = 0.0;
-    clock_t start = clock();
+    double start = wall_seconds();
+    clock_t cpu_start = clock();
+    Solve_Context ctx;
+    solve_ctx_init(&ctx, deadline, progress ? show_progress : NULL, NULL);
 
     // --- Méthodes ---
-    if (!strcmp(methode, "nn")) {
-        tour = nn_tour(inst);
+    if (!strcmp(methode, "all")) {
+        all = 1;
+        all_ctx.inst = inst;
+        all_ctx.params = params;
+        // les méthodes échantillonnées restent mono-thread : le parallélisme est entre méthodes
+        all_ctx.params.nb_threads = 1;
+        all_ctx.params.ga_trace = NULL;     // ga et gadpx écriraient dans le même fichier
+        all_ctx.ctx = &ctx;
+
+        // une tâche par méthode ; sans -t, autant de threads que de coeurs
+        int pool_size = threads_set ? params.nb_threads : (int)sysconf(_SC_NPROCESSORS_ONLN);
+        pool_run(SOLVER_ALL_NB, pool_size, all_task, &all_ctx);
+
+        for (int i = 0; i < SOLVER_ALL_NB; i++)
+            if (all_ctx.tours[i]) lengths[i] = tour_length(inst, all_ctx.tours[i]);
+    } else if (merge_files) {
+        tour = merge_tour_files(inst, merge_files);
         if (tour) length = tour_length(inst, tour);
-
-    } else if (!strcmp(methode, "rw")) {
-        tour = rw_tour(inst);
+    } else if (solver_is_method(methode) && dc_taille > 0) {
+        // un thread par cluster ; sans -t, autant que de coeurs
+        int nb_workers = threads_set ? params.nb_threads : (int)sysconf(_SC_NPROCESSORS_ONLN);
+        tour = decompose_solve(inst, methode, &params, dc_taille, nb_workers, &ctx);
         if (tour) length = tour_length(inst, tour);
-
-    } else if (!strcmp(methode, "nn2opt")) {
-        tour = nn_tour(inst);
-        if (tour) {
-            improve_2opt(inst, tour);
-            length = tour_length(inst, tour);
-        }
-
-    } else if (!strcmp(methode, "rw2opt")) {
-        tour = rw_tour(inst);
-        if (tour) {
-            improve_2opt(inst, tour);
-            length = tour_length(inst, tour);
-        }
-
-    } else if (!strcmp(methode, "bf")) {
-        tour = malloc(inst->dimension * sizeof(int));
-        if (tour) {
-            unsigned long long best_cost;
-            brute(inst->dimension, 0, tour, &best_cost, tsp_cost);
-            length = (double)best_cost;
-        }
-
-    } else if (!strcmp(methode, "ga")) {
-        tour = ga_tour(inst, pop_size, generations, mut_rate, 0);
-        if (tour) length = tour_length(inst, tour);
-
-    } else if (!strcmp(methode, "gadpx")) {
-        tour = ga_tour(inst, pop_size, generations, mut_rate, 1);
+    } else if (solver_is_method(methode)) {
+        tour = solver_run(methode, inst, &params, &ctx);
         if (tour) length = tour_length(inst, tour);
-    } else if (!strcmp(methode, "all")){
-        all = 1;
-        tours = malloc(sizeof(int*)*6);
-        elapses = malloc(sizeof(double)*6);
-        lengths = malloc(sizeof(double)*6);
-
-        start = clock();
-        tours[0] = nn_tour(inst); //nn
-        elapses[0] = (double)(clock()-start) / CLOCKS_PER_SEC;
-
-        start = clock();
-        tours[1] = rw_tour(inst); //rw
-        elapses[1] = (double)(clock()-start) / CLOCKS_PER_SEC;
-
-        start = clock();
-        tours[2] = nn_tour(inst); //nn2opt
-        improve_2opt(inst, tours[2]); //2opt
-        elapses[2] = (double)(clock()-start) / CLOCKS_PER_SEC;
-
-        start = clock();
-        tours[3] = rw_tour(inst); //rw2opt
-        improve_2opt(inst, tours[3]); //2opt
-        elapses[3] = (double)(clock()-start) / CLOCKS_PER_SEC;
-
-        start = clock();
-        tours[4] = ga_tour(inst, pop_size, generations, mut_rate, 0); //ga
-        elapses[4] = (double)(clock()-start) / CLOCKS_PER_SEC;
-
-        start = clock();
-        tours[5] = ga_tour(inst, pop_size, generations, mut_rate, 1); //gadpx
-        elapses[5] = (double)(clock()-start) / CLOCKS_PER_SEC;
-
-        for (int i = 0; i < 6; i++)
-            if (tours[i]) lengths[i] = tour_length(inst, tours[i]);
     } else {
         printf("Méthode inconnue.\n");
         return 3;
     }
 
-    double elapsed = (double)(clock() - start) / CLOCKS_PER_SEC;
+    double elapsed = wall_seconds() - start;
+    double cpu = (double)(clock() - cpu_start) / CLOCKS_PER_SEC;  // tous threads confondus
+
+    // --- Borne inférieure (Held-Karp), dans ce qui reste de l'échéance ---
+    double lb = borne ? held_karp_bound(inst, &ctx) : 0.0;
+
+    // Tournées ramenées aux identifiants du fichier pour l'affichage et les exports
+    if (ordre) {
+        if (tour) tour_to_original(tour, inst->dimension, ordre);
+        for (int i = 0; all && i < SOLVER_ALL_NB; i++)
+            if (all_ctx.tours[i]) tour_to_original(all_ctx.tours[i], inst->dimension, ordre);
+    }
 
     // --- Affichage ---
     if (stop_requested)
         printf("\n[!] Interruption utilisateur (Ctrl-C)\n");
+    else if (ctx.deadline > 0 && start + elapsed >= ctx.deadline)
+        printf("[!] Échéance de %.3fs atteinte : meilleure tournée à l'arrêt\n", deadline);
+    solve_ctx_destroy(&ctx);
 
+    int rc = 0;
     if (!all && tour) {
         printf("[!] Meilleure solution trouvée :\n");
         printf("Méthode : %s\n", methode);
 
-        printf("Tournée : ");
-        for (int i = 0; i < inst->dimension; ++i)
-            printf("%d ", tour[i] + 1);
-        printf("%d\n", tour[0] + 1);
+        if (show_tour) print_tour(tour, inst->dimension);
 
         printf("Longueur : %.0f\n", length);
+        if (lb > 0) {       // pas de borne : -nolb, -dc (sans matrice), échéance atteinte
+            printf("Borne inf: %.0f\n", lb);
+            printf("Écart    : %.2f%%\n", 100.0 * optimality_gap(length, lb));
+        }
         printf("Durée    : %.3fs\n", elapsed);
+        printf("CPU      : %.3fs\n", cpu);
 
         if (csv_file)
-            export_summary_csv(csv_file, inst->name, methode, elapsed, length, tour, inst->dimension, 1);
+            export_summary_csv(csv_file, inst->name, methode, elapsed, length, lb, tour, inst->dimension, 1);
+        if (tour_file) {
+            char comment[128];
+            snprintf(comment, sizeof(comment), "%s, longueur %.0f", methode, length);
+            export_tour(tour_file, inst->name, comment, tour, inst->dimension);
+        }
  
         free(tour);
     } else if (all){
         printf("[!] Execution de toutes les méthodes :\n");
-        char* methodes[] = {"nn", "rw", "nn2opt", "rw2opt", "ga", "gadpx"};
-        for (int i = 0; i < 6; i++){
-            printf("Méthode : %s\n", methodes[i]);
+        Tour_Buffer csv;        // lignes CSV regroupées : une seule écriture à la fin
+        tour_buf_init(&csv);
+        int entete = 1;
+        for (int i = 0; i < SOLVER_ALL_NB; i++){
+            int *t = all_ctx.tours[i];
+            if (!t) continue;
+            printf("Méthode : %s\n", solver_all_methodes[i]);
     
-            printf("Tournée : ");
-            for (int j = 0; j < inst->dimension; ++j)
-                printf("%d ", tours[i][j] + 1);
-            printf("%d\n", tours[i][0] + 1);
+            if (show_tour) print_tour(t, inst->dimension);
     
             printf("Longueur : %.0f\n", lengths[i]);
-            printf("Durée    : %.3fs\n\n", elapses[i]);
+            if (lb > 0) {   // -nolb, ou échéance atteinte avant la borne
+                printf("Borne inf: %.0f\n", lb);
+                printf("Écart    : %.2f%%\n", 100.0 * optimality_gap(lengths[i], lb));
+            }
+            printf("Durée    : %.3fs\n", all_ctx.wall[i]);
+            printf("CPU      : %.3fs\n\n", all_ctx.cpu[i]);
     
             if (csv_file)
-                export_summary_csv(csv_file, inst->name, methodes[i], elapses[i], lengths[i], tours[i], inst->dimension, !i);
+                summary_csv_format(&csv, inst->name, solver_all_methodes[i], all_ctx.wall[i], lengths[i], lb, t, inst->dimension, entete);
+            entete = 0;
     
-            free(tours[i]);
+            free(t);
         }
+        printf("Durée totale : %.3fs\n", elapsed);
+        if (csv_file) tour_buf_write_file(&csv, csv_file, 0);
+        tour_buf_free(&csv);
+    } else {
+        // aucune tournée (hk au-delà de sa limite, mémoire, --merge sans fichier valide...)
+        fprintf(stderr, "Échec de la méthode %s\n", methode);
+        rc = 3;
     }
 
     tsp_free_instance(inst);
-    return 0;
+    free(ordre);
+    report_stats(stats_json);
+    return rc;
 }
@@ -0,0 +1,49 @@
+/* neighbors.c
+ * Construit les listes de candidats (k plus proches voisins) à partir de inst->dist.
+ * Utilisées par les opérateurs qui restreignent leur recherche aux arêtes courtes.
+ */
+
+#include <stdlib.h>
+#include "neighbors.h"
+
+int *build_neighbor_lists(const TSP_Instance *inst, int k, int *k_out) {
+    int n = inst->dimension;
+    if (n <= 1 || !inst->dist) return NULL;
+
+    if (k > n - 1) k = n - 1;
+    if (k < 1) k = 1;
+
+    int *neigh = malloc((size_t)n * k * sizeof(int));
+    double *dbuf = malloc(k * sizeof(double));
+    if (!neigh || !dbuf) {
+        free(neigh);
+        free(dbuf);
+        return NULL;
+    }
+
+    for (int i = 0; i < n; ++i) {
+        int *nb = neigh + (size_t)i * k;
+        const double *row = inst->dist + (size_t)i * n;
+        int cnt = 0;
+
+        // Insertion triée dans un tampon de taille k
+        for (int j = 0; j < n; ++j) {
+            if (j == i) continue;
+            double d = row[j];
+            if (cnt == k && d >= dbuf[k - 1]) continue;
+
+            int p = (cnt < k) ? cnt++ : k - 1;
+            while (p > 0 && dbuf[p - 1] > d) {
+                dbuf[p] = dbuf[p - 1];
+                nb[p] = nb[p - 1];
+                p--;
+            }
+            dbuf[p] = d;
+            nb[p] = j;
+        }
+    }
+
+    free(dbuf);
+    if (k_out) *k_out = k;
+    return neigh;
+}
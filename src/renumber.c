@@ -0,0 +1,120 @@
+/* renumber.c
+ * Renumérotation des villes selon une courbe de Hilbert (localité mémoire de la
+ * matrice des distances) et retour des tournées aux identifiants d'origine.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "renumber.h"
+#include "distance.h"
+
+#define HILBERT_BITS 16
+#define HILBERT_COTE (1u << HILBERT_BITS)
+
+/* Indice de (x, y) sur la courbe de Hilbert d'une grille HILBERT_COTE x HILBERT_COTE */
+static uint32_t hilbert_index(uint32_t x, uint32_t y) {
+    uint32_t d = 0;
+    for (uint32_t s = HILBERT_COTE / 2; s > 0; s /= 2) {
+        uint32_t rx = (x & s) > 0;
+        uint32_t ry = (y & s) > 0;
+        d += s * s * ((3 * rx) ^ ry);
+        // rotation du quadrant
+        if (ry == 0) {
+            if (rx == 1) {
+                x = HILBERT_COTE - 1 - x;
+                y = HILBERT_COTE - 1 - y;
+            }
+            uint32_t t = x;
+            x = y;
+            y = t;
+        }
+    }
+    return d;
+}
+
+static int cmp_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static uint32_t grille(double v, double min, double echelle) {
+    double g = (v - min) * echelle;
+    if (g < 0) g = 0;
+    if (g > HILBERT_COTE - 1) g = HILBERT_COTE - 1;
+    return (uint32_t)g;
+}
+
+int *hilbert_order(const double *x, const double *y, int n) {
+    if (n <= 0) return NULL;
+    uint64_t *cles = malloc((size_t)n * sizeof(uint64_t));
+    int *ordre = malloc((size_t)n * sizeof(int));
+    if (!cles || !ordre) {
+        free(cles);
+        free(ordre);
+        return NULL;
+    }
+
+    double xmin = x[0], xmax = x[0], ymin = y[0], ymax = y[0];
+    for (int i = 1; i < n; ++i) {
+        if (x[i] < xmin) xmin = x[i];
+        if (x[i] > xmax) xmax = x[i];
+        if (y[i] < ymin) ymin = y[i];
+        if (y[i] > ymax) ymax = y[i];
+    }
+    // même échelle sur les deux axes : la courbe respecte les proportions
+    double etendue = (xmax - xmin > ymax - ymin) ? xmax - xmin : ymax - ymin;
+    double echelle = etendue > 0 ? (HILBERT_COTE - 1) / etendue : 0.0;
+
+    // clé = indice de Hilbert puis numéro de ville (départage stable)
+    for (int i = 0; i < n; ++i)
+        cles[i] = (uint64_t)hilbert_index(grille(x[i], xmin, echelle), grille(y[i], ymin, echelle)) << 32
+                | (uint32_t)i;
+    qsort(cles, n, sizeof(uint64_t), cmp_u64);
+    for (int k = 0; k < n; ++k)
+        ordre[k] = (int)(cles[k] & 0xFFFFFFFFu);
+    free(cles);
+    return ordre;
+}
+
+int *tsp_renumber_hilbert(TSP_Instance *inst) {
+    int n = inst->dimension;
+    int *ordre = hilbert_order(inst->x, inst->y, n);
+    double *x = malloc((size_t)n * sizeof(double));
+    double *y = malloc((size_t)n * sizeof(double));
+    if (!ordre || !x || !y) {
+        free(ordre);
+        free(x);
+        free(y);
+        return NULL;
+    }
+    for (int k = 0; k < n; ++k) {
+        x[k] = inst->x[ordre[k]];
+        y[k] = inst->y[ordre[k]];
+    }
+    free(inst->x);
+    free(inst->y);
+    inst->x = x;
+    inst->y = y;
+
+    if (inst->dist) {
+        free(inst->dist);
+        inst->dist = NULL;
+        build_distance_matrix(inst);
+    }
+    return ordre;
+}
+
+void tour_to_original(int *tour, int n, const int *ordre) {
+    if (!ordre || n <= 0) return;
+    int debut = 0;
+    for (int i = 0; i < n; ++i) {
+        tour[i] = ordre[tour[i]];
+        if (tour[i] == 0) debut = i;
+    }
+    // rotation : la tournée commence à la ville d'origine 0 (inversion de trois segments)
+    for (int a = 0, b = debut - 1; a < b; ++a, --b) { int t = tour[a]; tour[a] = tour[b]; tour[b] = t; }
+    for (int a = debut, b = n - 1; a < b; ++a, --b) { int t = tour[a]; tour[a] = tour[b]; tour[b] = t; }
+    for (int a = 0, b = n - 1; a < b; ++a, --b) { int t = tour[a]; tour[a] = tour[b]; tour[b] = t; }
+    tour[n] = tour[0];
+}
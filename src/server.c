@@ -0,0 +1,428 @@
+/* server.c
+ * Démon de résolution sur socket Unix : un thread accepte les connexions et les
+ * dépose dans une file, nb_workers threads les servent. Les instances lues (fichier
+ * ou coordonnées en ligne) restent en cache LRU : une requête répétée ne paie ni la
+ * lecture ni build_distance_matrix.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <signal.h>
+#include <errno.h>
+#include <unistd.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "server.h"
+#include "tsp_parser.h"
+#include "distance.h"
+#include "algo_nn.h"
+#include "algo_ga.h"
+#include "thread_pool.h"
+#include "tour_io.h"
+#include "hash.h"
+
+extern volatile sig_atomic_t stop_requested;
+
+#define SERVE_LIGNE_MAX 4096
+#define SERVE_FILE_MAX 64           /* connexions en attente d'un worker */
+#define SERVE_POLL_MS 200           /* période de vérification de Ctrl-C */
+
+/* ---------- Cache LRU des instances ---------- */
+
+typedef struct {
+    uint64_t key;                   /* empreinte du contenu */
+    TSP_Instance *inst;
+    int refs;                       /* requêtes en cours sur cette instance */
+    int cached;                     /* 0 : entrée temporaire (cache plein d'entrées utilisées) */
+    unsigned long last_use;
+} Cache_Entry;
+
+typedef struct {
+    Cache_Entry **entries;
+    int count, capacity;
+    unsigned long horloge;
+    pthread_mutex_t lock;
+} Instance_Cache;
+
+static Cache_Entry *cache_get(Instance_Cache *c, uint64_t key) {
+    Cache_Entry *e = NULL;
+    pthread_mutex_lock(&c->lock);
+    for (int i = 0; i < c->count; ++i)
+        if (c->entries[i]->key == key) {
+            e = c->entries[i];
+            e->refs++;
+            e->last_use = ++c->horloge;
+            break;
+        }
+    pthread_mutex_unlock(&c->lock);
+    return e;
+}
+
+/* Insère inst (qui appartient ensuite au cache) ; retourne l'entrée référencée */
+static Cache_Entry *cache_put(Instance_Cache *c, uint64_t key, TSP_Instance *inst) {
+    pthread_mutex_lock(&c->lock);
+
+    // chargée entre-temps par une autre requête : on garde la première
+    for (int i = 0; i < c->count; ++i)
+        if (c->entries[i]->key == key) {
+            Cache_Entry *e = c->entries[i];
+            e->refs++;
+            e->last_use = ++c->horloge;
+            pthread_mutex_unlock(&c->lock);
+            tsp_free_instance(inst);
+            return e;
+        }
+
+    Cache_Entry *e = malloc(sizeof(Cache_Entry));
+    if (!e) {
+        pthread_mutex_unlock(&c->lock);
+        tsp_free_instance(inst);
+        return NULL;
+    }
+    e->key = key;
+    e->inst = inst;
+    e->refs = 1;
+    e->last_use = ++c->horloge;
+    e->cached = 1;
+
+    int slot = c->count;
+    if (c->count == c->capacity) {
+        // éviction de la moins récemment utilisée parmi les entrées libres
+        slot = -1;
+        for (int i = 0; i < c->count; ++i)
+            if (c->entries[i]->refs == 0 && (slot < 0 || c->entries[i]->last_use < c->entries[slot]->last_use))
+                slot = i;
+        if (slot >= 0) {
+            tsp_free_instance(c->entries[slot]->inst);
+            free(c->entries[slot]);
+        } else {
+            e->cached = 0;
+        }
+    } else {
+        c->count++;
+    }
+    if (e->cached) c->entries[slot] = e;
+
+    pthread_mutex_unlock(&c->lock);
+    return e;
+}
+
+static void cache_release(Instance_Cache *c, Cache_Entry *e) {
+    if (!e) return;
+    pthread_mutex_lock(&c->lock);
+    e->refs--;
+    int libre = !e->cached;
+    pthread_mutex_unlock(&c->lock);
+    if (libre) {
+        tsp_free_instance(e->inst);
+        free(e);
+    }
+}
+
+/* ---------- Empreintes (FNV-1a 64 bits, hash.h) ---------- */
+
+/* Empreinte du contenu d'un fichier ; 0 et errno si illisible */
+static int hash_file(const char *path, uint64_t *h) {
+    FILE *fp = fopen(path, "rb");
+    if (!fp) return 0;
+    char buf[65536];
+    size_t k;
+    *h = fnv1a(FNV_INIT, "F", 1);
+    while ((k = fread(buf, 1, sizeof(buf), fp)) > 0)
+        *h = fnv1a(*h, buf, k);
+    fclose(fp);
+    return 1;
+}
+
+/* ---------- Requêtes ---------- */
+
+typedef struct {
+    Instance_Cache cache;
+    Solver_Params defaults;
+
+    int file[SERVE_FILE_MAX];       /* connexions acceptées, en attente */
+    int debut, nb;
+    int arret;
+    int *actifs;                    /* connexion servie par chaque worker, -1 si aucune */
+    pthread_mutex_t lock;
+    pthread_cond_t non_vide;
+    pthread_cond_t non_pleine;
+} Server;
+
+static const char *param(char **cles, char **valeurs, int nb, const char *cle) {
+    for (int i = 0; i < nb; ++i)
+        if (!strcmp(cles[i], cle))
+            return valeurs[i];
+    return NULL;
+}
+
+static void solve_request(Server *srv, char *ligne, FILE *in, FILE *out) {
+    char *cles[32], *valeurs[32];
+    int nb = 0;
+    strtok(ligne, " \t");   // "SOLVE"
+    for (char *t = strtok(NULL, " \t"); t && nb < 32; t = strtok(NULL, " \t")) {
+        char *eq = strchr(t, '=');
+        if (!eq) continue;
+        *eq = '\0';
+        cles[nb] = t;
+        valeurs[nb++] = eq + 1;
+    }
+
+    const char *methode = param(cles, valeurs, nb, "method");
+    if (!methode || !solver_is_method(methode)) {
+        fprintf(out, "ERR méthode absente ou inconnue\n");
+        return;
+    }
+
+    if (solver_needs_ga_params(methode) &&
+        (!param(cles, valeurs, nb, "pop") || !param(cles, valeurs, nb, "gen") || !param(cles, valeurs, nb, "mut"))) {
+        fprintf(out, "ERR %s demande pop, gen et mut\n", methode);
+        return;
+    }
+    Solver_Params p = srv->defaults;
+    for (int i = 0; i < nb; ++i)
+        solver_set_param(&p, cles[i], valeurs[i]);
+
+    // Instance : fichier ou coordonnées en ligne, via le cache
+    Cache_Entry *e = NULL;
+    int hit = 0;
+    const char *fichier = param(cles, valeurs, nb, "file");
+    const char *dim = param(cles, valeurs, nb, "n");
+    if (fichier) {
+        uint64_t h;
+        if (!hash_file(fichier, &h)) {
+            fprintf(out, "ERR %s : %s\n", fichier, strerror(errno));
+            return;
+        }
+        if ((e = cache_get(&srv->cache, h))) {
+            hit = 1;
+        } else {
+            TSP_Instance *inst = tsp_read_file(fichier);
+            if (!inst) {
+                fprintf(out, "ERR lecture de %s impossible\n", fichier);
+                return;
+            }
+            e = cache_put(&srv->cache, h, inst);
+        }
+    } else if (dim) {
+        int n = atoi(dim);
+        const char *type = param(cles, valeurs, nb, "type");
+        DistanceType dt = type ? parse_distance_type(type) : DIST_EUC_2D;
+        double *x = malloc((n > 0 ? n : 1) * sizeof(double));
+        double *y = malloc((n > 0 ? n : 1) * sizeof(double));
+        char buf[SERVE_LIGNE_MAX];
+        int lus = 0;
+        // exactement n lignes : une ligne invalide termine la lecture (pas de blocage)
+        while (x && y && lus < n && fgets(buf, sizeof(buf), in) &&
+               sscanf(buf, "%lf %lf", &x[lus], &y[lus]) == 2)
+            lus++;
+        if (n <= 0 || lus < n) {
+            fprintf(out, "ERR %d coordonnées attendues, %d lues\n", n, lus);
+            free(x);
+            free(y);
+            return;
+        }
+        uint64_t h = fnv1a(FNV_INIT, "C", 1);
+        h = fnv1a(h, &dt, sizeof(dt));
+        h = fnv1a(h, x, n * sizeof(double));
+        h = fnv1a(h, y, n * sizeof(double));
+        if ((e = cache_get(&srv->cache, h))) {
+            hit = 1;
+        } else {
+            TSP_Instance *inst = tsp_from_coords("inline", dt, n, x, y);
+            e = inst ? cache_put(&srv->cache, h, inst) : NULL;
+        }
+        free(x);
+        free(y);
+        if (!e) {
+            fprintf(out, "ERR instance invalide\n");
+            return;
+        }
+    } else {
+        fprintf(out, "ERR file=<fichier> ou n=<N> attendu\n");
+        return;
+    }
+    if (!e) {
+        fprintf(out, "ERR mémoire insuffisante\n");
+        return;
+    }
+
+    // deadline=<s> : la méthode rend sa meilleure tournée une fois le délai écoulé
+    const TSP_Instance *inst = e->inst;
+    const char *dl = param(cles, valeurs, nb, "deadline");
+    Solve_Context ctx;
+    solve_ctx_init(&ctx, dl ? atof(dl) : 0.0, NULL, NULL);
+    double t0 = wall_seconds();
+    int *tour = solver_run(methode, inst, &p, &ctx);
+    double elapsed = wall_seconds() - t0;
+    solve_ctx_destroy(&ctx);
+
+    if (tour) {
+        int n = inst->dimension;
+        fprintf(out, "OK length=%.0f time=%.6f n=%d cache=%s\n", tour_length(inst, tour), elapsed, n,
+                hit ? "hit" : "miss");
+        Tour_Buffer b;
+        tour_buf_init(&b);
+        tour_buf_cities(&b, tour, n, ' ', 1);
+        tour_buf_str(&b, "\n");
+        fwrite(b.data, 1, b.len, out);
+        tour_buf_free(&b);
+        free(tour);
+    } else {
+        fprintf(out, "ERR échec de %s\n", methode);
+    }
+    cache_release(&srv->cache, e);
+}
+
+static void handle_connection(Server *srv, int fd) {
+    FILE *in = fdopen(fd, "r");
+    int fd_out = dup(fd);
+    FILE *out = (fd_out >= 0) ? fdopen(fd_out, "w") : NULL;
+    if (!in || !out) {
+        if (in) fclose(in); else close(fd);
+        if (out) fclose(out); else if (fd_out >= 0) close(fd_out);
+        return;
+    }
+
+    char ligne[SERVE_LIGNE_MAX];
+    while (!stop_requested && fgets(ligne, sizeof(ligne), in)) {
+        ligne[strcspn(ligne, "\r\n")] = '\0';
+        if (!*ligne) continue;
+        if (!strcmp(ligne, "QUIT")) break;
+        if (!strcmp(ligne, "PING")) fprintf(out, "PONG\n");
+        else if (!strncmp(ligne, "SOLVE", 5)) solve_request(srv, ligne, in, out);
+        else fprintf(out, "ERR commande inconnue\n");
+        fflush(out);
+    }
+    fclose(out);
+    fclose(in);
+}
+
+typedef struct {
+    Server *srv;
+    int id;
+} Server_Worker;
+
+static void *worker_main(void *arg) {
+    Server_Worker *w = arg;
+    Server *srv = w->srv;
+    for (;;) {
+        pthread_mutex_lock(&srv->lock);
+        while (srv->nb == 0 && !srv->arret)
+            pthread_cond_wait(&srv->non_vide, &srv->lock);
+        if (srv->nb == 0) {
+            pthread_mutex_unlock(&srv->lock);
+            return NULL;
+        }
+        int fd = srv->file[srv->debut];
+        srv->debut = (srv->debut + 1) % SERVE_FILE_MAX;
+        srv->nb--;
+        srv->actifs[w->id] = fd;
+        pthread_cond_signal(&srv->non_pleine);
+        pthread_mutex_unlock(&srv->lock);
+
+        handle_connection(srv, fd);
+
+        pthread_mutex_lock(&srv->lock);
+        srv->actifs[w->id] = -1;
+        pthread_mutex_unlock(&srv->lock);
+    }
+}
+
+int serve(const char *socket_path, const Solver_Params *defaults, int nb_workers, int cache_capacity) {
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(socket_path) >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "Chemin de socket trop long : %s\n", socket_path);
+        return 1;
+    }
+    strcpy(addr.sun_path, socket_path);
+
+    int ls = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (ls < 0) {
+        perror("socket");
+        return 1;
+    }
+    unlink(socket_path);
+    if (bind(ls, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(ls, SERVE_FILE_MAX) < 0) {
+        perror("Erreur d'écoute sur la socket");
+        close(ls);
+        return 1;
+    }
+    signal(SIGPIPE, SIG_IGN);   // client parti : l'écriture échoue sans tuer le démon
+
+    if (nb_workers < 1) nb_workers = 1;
+    if (cache_capacity < 1) cache_capacity = 1;
+
+    Server srv;
+    memset(&srv, 0, sizeof(srv));
+    srv.defaults = *defaults;
+    srv.cache.capacity = cache_capacity;
+    srv.cache.entries = calloc(cache_capacity, sizeof(Cache_Entry *));
+    pthread_mutex_init(&srv.cache.lock, NULL);
+    pthread_mutex_init(&srv.lock, NULL);
+    pthread_cond_init(&srv.non_vide, NULL);
+    pthread_cond_init(&srv.non_pleine, NULL);
+
+    pthread_t *workers = malloc(nb_workers * sizeof(pthread_t));
+    Server_Worker *ids = malloc(nb_workers * sizeof(Server_Worker));
+    srv.actifs = malloc(nb_workers * sizeof(int));
+    int started = 0;
+    while (workers && ids && srv.actifs && srv.cache.entries && started < nb_workers) {
+        ids[started] = (Server_Worker){ &srv, started };
+        srv.actifs[started] = -1;
+        if (pthread_create(&workers[started], NULL, worker_main, &ids[started]) != 0)
+            break;
+        started++;
+    }
+
+    fprintf(stderr, "[serve] %s : %d workers, cache de %d instances\n", socket_path, started, cache_capacity);
+
+    struct pollfd pfd = { ls, POLLIN, 0 };
+    while (started > 0 && !stop_requested) {
+        int r = poll(&pfd, 1, SERVE_POLL_MS);
+        if (r <= 0) continue;
+        int fd = accept(ls, NULL, NULL);
+        if (fd < 0) continue;
+
+        pthread_mutex_lock(&srv.lock);
+        while (srv.nb == SERVE_FILE_MAX && !stop_requested)
+            pthread_cond_wait(&srv.non_pleine, &srv.lock);
+        srv.file[(srv.debut + srv.nb) % SERVE_FILE_MAX] = fd;
+        srv.nb++;
+        pthread_cond_signal(&srv.non_vide);
+        pthread_mutex_unlock(&srv.lock);
+    }
+
+    // Arrêt : les connexions en cours sont coupées en lecture (la requête en cours
+    // reçoit sa réponse), celles encore en file sont fermées sans être servies
+    close(ls);
+    unlink(socket_path);
+    pthread_mutex_lock(&srv.lock);
+    srv.arret = 1;
+    for (int t = 0; t < started; ++t)
+        if (srv.actifs[t] >= 0) shutdown(srv.actifs[t], SHUT_RD);
+    pthread_cond_broadcast(&srv.non_vide);
+    pthread_mutex_unlock(&srv.lock);
+    for (int t = 0; t < started; ++t)
+        pthread_join(workers[t], NULL);
+
+    for (int i = 0; i < srv.cache.count; ++i) {
+        tsp_free_instance(srv.cache.entries[i]->inst);
+        free(srv.cache.entries[i]);
+    }
+    free(srv.cache.entries);
+    free(workers);
+    free(ids);
+    free(srv.actifs);
+    pthread_cond_destroy(&srv.non_pleine);
+    pthread_cond_destroy(&srv.non_vide);
+    pthread_mutex_destroy(&srv.lock);
+    pthread_mutex_destroy(&srv.cache.lock);
+    return started > 0 ? 0 : 1;
+}
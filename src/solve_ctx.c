@@ -0,0 +1,54 @@
+/* solve_ctx.c
+ * Contexte de résolution : annulation, échéance monotone et rappel de progression.
+ * Ctrl-C (stop_requested) reste global au processus et arrête toutes les résolutions.
+ */
+
+#include <float.h>
+#include <signal.h>
+#include "solve_ctx.h"
+#include "thread_pool.h"
+
+extern volatile sig_atomic_t stop_requested;
+
+void solve_ctx_init(Solve_Context *ctx, double budget, Solve_Progress progress, void *user) {
+    atomic_init(&ctx->cancelled, 0);
+    ctx->start = wall_seconds();
+    ctx->deadline = (budget > 0) ? ctx->start + budget : 0.0;
+    ctx->progress = progress;
+    ctx->user = user;
+    pthread_mutex_init(&ctx->lock, NULL);
+    ctx->best = DBL_MAX;
+}
+
+void solve_ctx_restart(Solve_Context *ctx, double budget) {
+    pthread_mutex_lock(&ctx->lock);
+    ctx->start = wall_seconds();
+    ctx->deadline = (budget > 0) ? ctx->start + budget : 0.0;
+    ctx->best = DBL_MAX;
+    pthread_mutex_unlock(&ctx->lock);
+}
+
+void solve_ctx_destroy(Solve_Context *ctx) {
+    pthread_mutex_destroy(&ctx->lock);
+}
+
+void solve_ctx_cancel(Solve_Context *ctx) {
+    atomic_store(&ctx->cancelled, 1);
+}
+
+int solve_ctx_stop(const Solve_Context *ctx) {
+    if (stop_requested) return 1;
+    if (!ctx) return 0;
+    if (atomic_load_explicit(&ctx->cancelled, memory_order_relaxed)) return 1;
+    return ctx->deadline > 0 && wall_seconds() >= ctx->deadline;
+}
+
+void solve_ctx_report(Solve_Context *ctx, double length) {
+    if (!ctx || !ctx->progress) return;
+    pthread_mutex_lock(&ctx->lock);
+    if (length < ctx->best) {
+        ctx->best = length;
+        ctx->progress(ctx->user, length, wall_seconds() - ctx->start);
+    }
+    pthread_mutex_unlock(&ctx->lock);
+}
@@ -0,0 +1,236 @@
+/* solver.c
+ * Point d'entrée unique des méthodes de résolution : associe un nom de méthode
+ * (option -m) à l'algorithme correspondant. Utilisé par main et le mode batch.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include "solver.h"
+#include "algo_nn.h"
+#include "algo_bf.h"
+#include "algo_bb.h"
+#include "algo_hk.h"
+#include "algo_rw.h"
+#include "algo_2opt.h"
+#include "algo_ga.h"
+#include "algo_sa.h"
+#include "algo_acs.h"
+#include "tour_io.h"
+
+#define BFENUM_CK_TYPE "BE01"
+
+// Hooks BF (API incrémentale de brute_incr) : ville 0 fixée en tête,
+// coût du préfixe arête par arête, minorant = une arête minimale par ville restante
+typedef struct {
+    const TSP_Instance *inst;
+    unsigned long long *min_edge;   // plus petite arête incidente de chaque ville
+    Solve_Context *solve;
+} TSP_BF_Context;
+
+static unsigned long long tsp_extend(void *ctx, const int *perm, int pos) {
+    const TSP_BF_Context *c = ctx;
+    if (pos == 0)
+        return perm[0] == 0 ? 0 : BF_INFEASIBLE;
+    int n = c->inst->dimension;
+    return (unsigned long long)c->inst->dist[perm[pos - 1] * n + perm[pos]];
+}
+
+static unsigned long long tsp_close(void *ctx, const int *perm, int n) {
+    const TSP_BF_Context *c = ctx;
+    // chaque tournée n'est comptée que dans un sens
+    if (n >= 3 && perm[1] > perm[n - 1])
+        return BF_INFEASIBLE;
+    return (unsigned long long)c->inst->dist[perm[n - 1] * n + perm[0]];
+}
+
+static unsigned long long tsp_bound(void *ctx, const int *perm, int pos, const bool *used) {
+    const TSP_BF_Context *c = ctx;
+    int n = c->inst->dimension;
+    unsigned long long lb = c->min_edge[perm[pos]];
+    for (int v = 0; v < n; ++v)
+        if (!used[v]) lb += c->min_edge[v];
+    return lb;
+}
+
+static int tsp_stop(void *ctx) {
+    const TSP_BF_Context *c = ctx;
+    return solve_ctx_stop(c->solve);
+}
+
+// Sauvegarde bfenum : signature de l'instance suivie de l'état opaque du moteur
+typedef struct {
+    const char *file;
+    uint64_t signature;
+} BFEnum_Sauvegarde;
+
+static int bfenum_save(void *user, const void *etat, size_t taille) {
+    const BFEnum_Sauvegarde *s = user;
+    Tour_Buffer b;
+    tour_buf_init(&b);
+    tour_buf_bytes(&b, &s->signature, sizeof(s->signature));
+    tour_buf_bytes(&b, etat, taille);
+    int r = b.erreur ? -1 : checkpoint_write(s->file, BFENUM_CK_TYPE, b.data, b.len);
+    tour_buf_free(&b);
+    return r;
+}
+
+static int *bfenum_tour(const TSP_Instance *inst, int nb_threads, Solve_Context *solve,
+                        const Checkpoint_Options *opt) {
+    // Énumération exhaustive via le moteur générique brute_incr()
+    int n = inst->dimension;
+    TSP_BF_Context ctx = { inst, malloc(n * sizeof(unsigned long long)), solve };
+    int *tour = malloc((n + 1) * sizeof(int));
+    if (tour && ctx.min_edge) {
+        for (int u = 0; u < n; ++u) {
+            double m = -1.0;
+            for (int v = 0; v < n; ++v)
+                if (v != u && (m < 0 || inst->dist[u * n + v] < m))
+                    m = inst->dist[u * n + v];
+            ctx.min_edge[u] = (m < 0) ? 0 : (unsigned long long)m;
+        }
+        BF_Hooks hooks = { tsp_extend, NULL, tsp_close, tsp_bound, tsp_stop };
+        unsigned long long best_cost;
+        // arrêt avant la première tournée complète : la tournée identité est rendue
+        for (int i = 0; i < n; ++i)
+            tour[i] = i;
+        if (opt && opt->file) {
+            BFEnum_Sauvegarde s = { opt->file, checkpoint_signature(inst) };
+            BF_Checkpoint cp = { opt->periode, bfenum_save, NULL, 0, &s, 0 };
+            size_t len = 0;
+            unsigned char *data = opt->reprise ? checkpoint_read(opt->file, BFENUM_CK_TYPE, &len) : NULL;
+            if (data && len >= sizeof(uint64_t) && !memcmp(data, &s.signature, sizeof(uint64_t))) {
+                cp.reprise = data + sizeof(uint64_t);
+                cp.reprise_taille = len - sizeof(uint64_t);
+            }
+            brute_incr_cp(n, nb_threads, tour, &best_cost, &hooks, &ctx, &cp);
+            if (cp.repris)
+                fprintf(stderr, "[BF] reprise de %s\n", opt->file);
+            else if (data)
+                fprintf(stderr, "[BF] %s : sauvegarde d'une autre instance, ignorée\n", opt->file);
+            free(data);
+        } else {
+            brute_incr(n, nb_threads, tour, &best_cost, &hooks, &ctx);
+        }
+        tour[n] = tour[0];
+    } else {
+        free(tour);
+        tour = NULL;
+    }
+    free(ctx.min_edge);
+    return tour;
+}
+
+// Interruption demandée (Ctrl-C) : positionné par le programme hôte, lu par les boucles longues
+volatile sig_atomic_t stop_requested = 0;
+
+static const char *methodes[] = {
+    "nn", "nnms", "nnms2opt", "rw", "nn2opt", "rw2opt", "bf", "hk", "bfenum", "ga", "gadpx", "gaeax", "gagpx", "sa", "acs", "acs2opt"
+};
+
+const char *const solver_all_methodes[SOLVER_ALL_NB] = {"nn", "rw", "nn2opt", "rw2opt", "ga", "gadpx"};
+
+void solver_default_params(Solver_Params *p) {
+    p->pop_size = 0;
+    p->generations = 0;
+    p->mut_rate = 0.0;
+    p->mutation = GA_MUT_SWAP;
+    p->nb_threads = 1;
+    p->nn_departs = 0;
+    p->nn_top_k = 3;
+    p->rw_samples = 0;      // par défaut : un seul tirage
+    p->rw_budget = 0.0;
+    p->seed = 0;
+    p->ga_trace = NULL;
+    p->ga_stagnation = 0;
+    p->checkpoint.file = NULL;
+    p->checkpoint.periode = CHECKPOINT_PERIODE_DEFAUT;
+    p->checkpoint.reprise = 0;
+}
+
+int solver_is_method(const char *methode) {
+    for (size_t i = 0; i < sizeof(methodes) / sizeof(methodes[0]); ++i)
+        if (!strcmp(methode, methodes[i]))
+            return 1;
+    return 0;
+}
+
+int solver_needs_ga_params(const char *methode) {
+    return !strcmp(methode, "ga") || !strcmp(methode, "gadpx") || !strcmp(methode, "gaeax") || !strcmp(methode, "gagpx")
+        || !strcmp(methode, "all");
+}
+
+int solver_set_param(Solver_Params *p, const char *cle, const char *valeur) {
+    if (!strcmp(cle, "pop")) p->pop_size = atoi(valeur);
+    else if (!strcmp(cle, "gen")) p->generations = atoi(valeur);
+    else if (!strcmp(cle, "mut")) p->mut_rate = atof(valeur);
+    else if (!strcmp(cle, "mt")) {
+        if (!strcmp(valeur, "swap")) p->mutation = GA_MUT_SWAP;
+        else if (!strcmp(valeur, "inv")) p->mutation = GA_MUT_INVERSION;
+        else if (!strcmp(valeur, "ins")) p->mutation = GA_MUT_INSERTION;
+    }
+    else if (!strcmp(cle, "seed")) p->seed = (unsigned int)strtoul(valeur, NULL, 10);
+    else if (!strcmp(cle, "samples")) p->rw_samples = atoll(valeur);
+    else if (!strcmp(cle, "budget")) p->rw_budget = atof(valeur);
+    else if (!strcmp(cle, "starts")) p->nn_departs = atoi(valeur);
+    else if (!strcmp(cle, "k")) p->nn_top_k = atoi(valeur) > 0 ? atoi(valeur) : 1;
+    else if (!strcmp(cle, "threads")) p->nb_threads = atoi(valeur) > 0 ? atoi(valeur) : 1;
+    else if (!strcmp(cle, "stagnation")) p->ga_stagnation = atoi(valeur);
+    else return 0;
+    return 1;
+}
+
+int *solver_run(const char *methode, const TSP_Instance *inst, const Solver_Params *p, Solve_Context *ctx) {
+    int *tour = NULL;
+
+    if (!strcmp(methode, "nn")) {
+        tour = nn_tour(inst, ctx);
+
+    } else if (!strcmp(methode, "nnms")) {
+        tour = nn_multistart(inst, p->nn_departs, p->nb_threads, 0, ctx);
+
+    } else if (!strcmp(methode, "nnms2opt")) {
+        tour = nn_multistart(inst, p->nn_departs, p->nb_threads, p->nn_top_k, ctx);
+
+    } else if (!strcmp(methode, "rw")) {
+        tour = rw_sample(inst, p->rw_samples, p->rw_budget, p->nb_threads, 0, p->seed, ctx);
+
+    } else if (!strcmp(methode, "nn2opt")) {
+        tour = nn_tour(inst, ctx);
+        if (tour) improve_2opt(inst, tour, ctx);
+
+    } else if (!strcmp(methode, "rw2opt")) {
+        tour = rw_sample(inst, p->rw_samples, p->rw_budget, p->nb_threads, 1, p->seed, ctx);
+
+    } else if (!strcmp(methode, "bf")) {
+        tour = bb_tour(inst, ctx, &p->checkpoint);
+
+    } else if (!strcmp(methode, "hk")) {
+        tour = hk_tour(inst, ctx);
+
+    } else if (!strcmp(methode, "bfenum")) {
+        tour = bfenum_tour(inst, p->nb_threads, ctx, &p->checkpoint);
+
+    } else if (!strcmp(methode, "sa")) {
+        tour = sa_tour(inst, p->rw_budget, p->nb_threads, p->seed, ctx);
+
+    } else if (!strcmp(methode, "acs") || !strcmp(methode, "acs2opt")) {
+        tour = acs_tour(inst, p->rw_budget, p->nb_threads, !strcmp(methode, "acs2opt"), p->seed, ctx);
+
+    } else if (!strcmp(methode, "ga") || !strcmp(methode, "gadpx") || !strcmp(methode, "gaeax")
+               || !strcmp(methode, "gagpx")) {
+        int crossover = !strcmp(methode, "ga") ? GA_CROSS_OX
+                      : !strcmp(methode, "gadpx") ? GA_CROSS_DPX
+                      : !strcmp(methode, "gaeax") ? GA_CROSS_EAX : GA_CROSS_GPX;
+        GA_Suivi suivi = { p->ga_trace, p->ga_stagnation, &p->checkpoint };
+        tour = ga_tour_suivi(inst, p->pop_size, p->generations, p->mut_rate, crossover, p->mutation,
+                             p->seed, &suivi, ctx);
+    }
+
+    // dernière longueur (méthodes exactes, tournée finale) ; ignorée si rien n'est amélioré
+    if (tour && solve_ctx_wants_progress(ctx))
+        solve_ctx_report(ctx, tour_length(inst, tour));
+
+    return tour;
+}
@@ -0,0 +1,72 @@
+/* stats.c
+ * Compteurs et chronomètres de l'option --stats. Les durées sont cumulées en
+ * nanosecondes dans des compteurs atomiques : les phases exécutées en parallèle
+ * (-m all, batch) s'additionnent.
+ */
+
+#include <stdio.h>
+#include <sys/resource.h>
+#include "stats.h"
+#include "thread_pool.h"
+
+int stats_enabled = 0;
+_Atomic unsigned long long stats_counters[STAT_NB_COMPTEURS];
+
+static _Atomic unsigned long long phase_ns[STAT_NB_PHASES];
+static _Atomic unsigned long long phase_calls[STAT_NB_PHASES];
+
+static const char *phase_noms[STAT_NB_PHASES] = {
+    "parse", "matrix", "construct", "improve", "ga", "bound"
+};
+
+static const char *compteur_noms[STAT_NB_COMPTEURS] = {
+    "dist_lookups", "2opt_evals", "2opt_moves", "ga_generations",
+    "crossovers", "cache_lookups", "cache_hits",
+    "sa_moves", "sa_accepted", "acs_ants", "gpx_partitions"
+};
+
+double stats_begin(void) {
+    return stats_enabled ? wall_seconds() : 0.0;
+}
+
+void stats_end(Stat_Phase p, double t0) {
+    if (!stats_enabled) return;
+    double dt = wall_seconds() - t0;
+    atomic_fetch_add_explicit(&phase_ns[p], (unsigned long long)(dt * 1e9), memory_order_relaxed);
+    atomic_fetch_add_explicit(&phase_calls[p], 1, memory_order_relaxed);
+}
+
+/* Pic de mémoire résidente en Ko (ru_maxrss est en Ko sous Linux) */
+static long peak_rss_kb(void) {
+    struct rusage ru;
+    return getrusage(RUSAGE_SELF, &ru) == 0 ? ru.ru_maxrss : 0;
+}
+
+void stats_print(FILE *out) {
+    fprintf(out, "[stats] phases :\n");
+    for (int p = 0; p < STAT_NB_PHASES; ++p)
+        fprintf(out, "  %-10s %10.3fs  (%llu appels)\n", phase_noms[p],
+                atomic_load(&phase_ns[p]) * 1e-9, atomic_load(&phase_calls[p]));
+    fprintf(out, "[stats] compteurs :\n");
+    for (int c = 0; c < STAT_NB_COMPTEURS; ++c)
+        fprintf(out, "  %-15s %llu\n", compteur_noms[c], atomic_load(&stats_counters[c]));
+    fprintf(out, "  %-15s %ld Ko\n", "peak_rss", peak_rss_kb());
+}
+
+int stats_export_json(const char *filename) {
+    FILE *fp = fopen(filename, "w");
+    if (!fp) {
+        perror("Erreur ouverture fichier JSON");
+        return -1;
+    }
+    fprintf(fp, "{\n  \"phases\": {");
+    for (int p = 0; p < STAT_NB_PHASES; ++p)
+        fprintf(fp, "%s\n    \"%s\": {\"seconds\": %.6f, \"calls\": %llu}", p ? "," : "", phase_noms[p],
+                atomic_load(&phase_ns[p]) * 1e-9, atomic_load(&phase_calls[p]));
+    fprintf(fp, "\n  },\n  \"counters\": {");
+    for (int c = 0; c < STAT_NB_COMPTEURS; ++c)
+        fprintf(fp, "%s\n    \"%s\": %llu", c ? "," : "", compteur_noms[c], atomic_load(&stats_counters[c]));
+    fprintf(fp, "\n  },\n  \"peak_rss_kb\": %ld\n}\n", peak_rss_kb());
+    fclose(fp);
+    return 0;
+}
@@ -0,0 +1,77 @@
+/* thread_pool.c
+ * Pool de threads minimal : un compteur atomique distribue les indices de tâches
+ * aux threads, qui s'arrêtent quand il n'en reste plus.
+ */
+
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "thread_pool.h"
+
+typedef struct {
+    void (*task)(void *, int, int);
+    void *ctx;
+    int nb_tasks;
+    atomic_int next;
+} Pool;
+
+typedef struct {
+    Pool *pool;
+    int id;
+    pthread_t thread;
+} Pool_Worker;
+
+static void *pool_worker_main(void *arg) {
+    Pool_Worker *w = arg;
+    Pool *p = w->pool;
+    int idx;
+    while ((idx = atomic_fetch_add(&p->next, 1)) < p->nb_tasks)
+        p->task(p->ctx, idx, w->id);
+    return NULL;
+}
+
+void pool_run(int nb_tasks, int nb_threads, void (*task)(void *ctx, int idx, int worker), void *ctx) {
+    if (nb_tasks <= 0) return;
+    if (nb_threads > nb_tasks) nb_threads = nb_tasks;
+    if (nb_threads < 1) nb_threads = 1;
+
+    Pool p = { task, ctx, nb_tasks, 0 };
+    atomic_init(&p.next, 0);
+
+    Pool_Worker *workers = calloc(nb_threads, sizeof(Pool_Worker));
+    if (!workers) {
+        Pool_Worker seul = { &p, 0, 0 };
+        pool_worker_main(&seul);
+        return;
+    }
+
+    int started = 0;
+    for (int t = 1; t < nb_threads; ++t) {
+        workers[t].pool = &p;
+        workers[t].id = t;
+        if (pthread_create(&workers[t].thread, NULL, pool_worker_main, &workers[t]) != 0)
+            break;
+        started++;
+    }
+    // le thread appelant est le worker 0
+    workers[0].pool = &p;
+    workers[0].id = 0;
+    pool_worker_main(&workers[0]);
+
+    for (int t = 1; t <= started; ++t)
+        pthread_join(workers[t].thread, NULL);
+    free(workers);
+}
+
+double wall_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+double thread_cpu_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
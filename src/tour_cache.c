@@ -0,0 +1,177 @@
+/* tour_cache.c
+ * Empreinte canonique des tournées et cache borné des optimisations locales.
+ * Table associative par ensembles de 4 entrées ; en cas de conflit une entrée
+ * de l'ensemble est écrasée (choisie à partir de la clé).
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "tour_cache.h"
+#include "stats.h"
+#include "rng.h"
+
+#define CACHE_WAYS 4
+
+struct Tour_Cache {
+    int n;
+    int nb_sets;             /* puissance de 2 */
+    uint64_t *keys;          /* nb_sets * CACHE_WAYS */
+    double *lengths;
+    unsigned char *valid;
+    int *tours;              /* nb_sets * CACHE_WAYS * n */
+    unsigned long long lookups;
+    unsigned long long hits;
+};
+
+/* Finaliseur splitmix64 : tient lieu de table de Zobrist indexée par arête */
+static inline uint64_t mix64(uint64_t x) {
+    return splitmix64(&x);
+}
+
+uint64_t tour_hash(const int *perm, int n) {
+    uint64_t h = 0;
+    for (int i = 0; i < n; ++i) {
+        uint32_t u = (uint32_t)perm[i];
+        uint32_t v = (uint32_t)perm[(i + 1 == n) ? 0 : i + 1];
+        if (u > v) { uint32_t t = u; u = v; v = t; }
+        h += mix64(((uint64_t)u << 32) | v);
+    }
+    return h;
+}
+
+Tour_Cache *tour_cache_create(int n, int min_slots, size_t max_bytes) {
+    if (n <= 0) return NULL;
+
+    // Nombre d'ensembles : puissance de 2 couvrant min_slots, dans la limite de max_bytes
+    size_t per_set = (size_t)CACHE_WAYS * n * sizeof(int);
+    int nb_sets = 1;
+    while (nb_sets * CACHE_WAYS < min_slots && (size_t)(nb_sets * 2) * per_set <= max_bytes)
+        nb_sets *= 2;
+
+    Tour_Cache *cache = calloc(1, sizeof(Tour_Cache));
+    if (!cache) return NULL;
+
+    size_t slots = (size_t)nb_sets * CACHE_WAYS;
+    cache->n = n;
+    cache->nb_sets = nb_sets;
+    cache->keys    = malloc(slots * sizeof(uint64_t));
+    cache->lengths = malloc(slots * sizeof(double));
+    cache->valid   = calloc(slots, 1);
+    cache->tours   = malloc(slots * n * sizeof(int));
+
+    if (!cache->keys || !cache->lengths || !cache->valid || !cache->tours) {
+        tour_cache_free(cache);
+        return NULL;
+    }
+    return cache;
+}
+
+void tour_cache_free(Tour_Cache *cache) {
+    if (!cache) return;
+    stats_add(STAT_CACHE_LOOKUPS, cache->lookups);
+    stats_add(STAT_CACHE_HITS, cache->hits);
+    free(cache->keys);
+    free(cache->lengths);
+    free(cache->valid);
+    free(cache->tours);
+    free(cache);
+}
+
+int tour_cache_lookup(Tour_Cache *cache, uint64_t key, int *perm_out, double *length_out) {
+    size_t base = (size_t)(key & (uint64_t)(cache->nb_sets - 1)) * CACHE_WAYS;
+
+    cache->lookups++;
+    for (int w = 0; w < CACHE_WAYS; ++w) {
+        size_t s = base + w;
+        if (cache->valid[s] && cache->keys[s] == key) {
+            memcpy(perm_out, cache->tours + s * cache->n, cache->n * sizeof(int));
+            *length_out = cache->lengths[s];
+            cache->hits++;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+void tour_cache_insert(Tour_Cache *cache, uint64_t key, const int *perm, double length) {
+    size_t base = (size_t)(key & (uint64_t)(cache->nb_sets - 1)) * CACHE_WAYS;
+    size_t slot = base + (size_t)((key >> 32) % CACHE_WAYS);
+
+    for (int w = 0; w < CACHE_WAYS; ++w) {
+        size_t s = base + w;
+        if (!cache->valid[s] || cache->keys[s] == key) {
+            slot = s;
+            break;
+        }
+    }
+
+    cache->valid[slot] = 1;
+    cache->keys[slot] = key;
+    cache->lengths[slot] = length;
+    memcpy(cache->tours + slot * cache->n, perm, cache->n * sizeof(int));
+}
+
+void tour_cache_stats(const Tour_Cache *cache, unsigned long long *lookups, unsigned long long *hits) {
+    *lookups = cache ? cache->lookups : 0;
+    *hits = cache ? cache->hits : 0;
+}
+
+/* État : nb_sets, nombre d'entrées, puis (emplacement, clé, longueur, tournée) par entrée */
+typedef struct {
+    uint64_t slot, key;
+    double length;
+} Cache_Entry_Header;
+
+static size_t nb_valid(const Tour_Cache *cache) {
+    size_t slots = (size_t)cache->nb_sets * CACHE_WAYS, k = 0;
+    for (size_t s = 0; s < slots; ++s)
+        k += cache->valid[s];
+    return k;
+}
+
+size_t tour_cache_state_size(const Tour_Cache *cache) {
+    return 2 * sizeof(uint64_t) + nb_valid(cache) * (sizeof(Cache_Entry_Header) + cache->n * sizeof(int));
+}
+
+void tour_cache_state_get(const Tour_Cache *cache, void *dst) {
+    unsigned char *p = dst;
+    uint64_t h[2] = { (uint64_t)cache->nb_sets, nb_valid(cache) };
+    memcpy(p, h, sizeof(h));
+    p += sizeof(h);
+    size_t slots = (size_t)cache->nb_sets * CACHE_WAYS;
+    for (size_t s = 0; s < slots; ++s) {
+        if (!cache->valid[s]) continue;
+        Cache_Entry_Header e = { s, cache->keys[s], cache->lengths[s] };
+        memcpy(p, &e, sizeof(e));
+        p += sizeof(e);
+        memcpy(p, cache->tours + s * cache->n, cache->n * sizeof(int));
+        p += cache->n * sizeof(int);
+    }
+}
+
+int tour_cache_state_set(Tour_Cache *cache, const void *src, size_t len) {
+    const unsigned char *p = src;
+    uint64_t h[2];
+    size_t slots = (size_t)cache->nb_sets * CACHE_WAYS;
+    size_t entry = sizeof(Cache_Entry_Header) + cache->n * sizeof(int);
+    if (len < sizeof(h)) return 0;
+    memcpy(h, p, sizeof(h));
+    if (h[0] != (uint64_t)cache->nb_sets || h[1] > slots || len != sizeof(h) + h[1] * entry)
+        return 0;
+    p += sizeof(h);
+
+    memset(cache->valid, 0, slots);
+    for (uint64_t k = 0; k < h[1]; ++k, p += entry) {
+        Cache_Entry_Header e;
+        memcpy(&e, p, sizeof(e));
+        if (e.slot >= slots) {
+            memset(cache->valid, 0, slots);
+            return 0;
+        }
+        cache->valid[e.slot] = 1;
+        cache->keys[e.slot] = e.key;
+        cache->lengths[e.slot] = e.length;
+        memcpy(cache->tours + e.slot * cache->n, p + sizeof(e), cache->n * sizeof(int));
+    }
+    return 1;
+}
@@ -0,0 +1,221 @@
+/* tour_io.c
+ * Sérialisation des tournées : tampon de sortie, conversion rapide des entiers,
+ * formats CSV, TSPLIB (.tour) et binaire. Une sortie = un seul appel à write.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "tour_io.h"
+#include "csv_export.h"
+
+#define TOUR_BIN_MAGIC "TSPT"
+#define TOUR_BIN_VERSION 1u
+
+void tour_buf_init(Tour_Buffer *b) {
+    b->data = NULL;
+    b->len = 0;
+    b->cap = 0;
+    b->erreur = 0;
+}
+
+void tour_buf_free(Tour_Buffer *b) {
+    free(b->data);
+    tour_buf_init(b);
+}
+
+/* Garantit de la place pour extra octets ; 0 si l'allocation échoue */
+static int reserve(Tour_Buffer *b, size_t extra) {
+    if (b->erreur) return 0;
+    if (b->len + extra <= b->cap) return 1;
+    size_t cap = b->cap ? b->cap : 4096;
+    while (cap < b->len + extra) cap *= 2;
+    char *data = realloc(b->data, cap);
+    if (!data) {
+        b->erreur = 1;
+        return 0;
+    }
+    b->data = data;
+    b->cap = cap;
+    return 1;
+}
+
+void tour_buf_str(Tour_Buffer *b, const char *s) {
+    size_t l = strlen(s);
+    if (!reserve(b, l)) return;
+    memcpy(b->data + b->len, s, l);
+    b->len += l;
+}
+
+void tour_buf_bytes(Tour_Buffer *b, const void *data, size_t len) {
+    if (!reserve(b, len)) return;
+    memcpy(b->data + b->len, data, len);
+    b->len += len;
+}
+
+/* Chiffres écrits de droite à gauche dans un tampon local, puis recopiés */
+static inline void put_int(Tour_Buffer *b, long long v) {
+    char tmp[24];
+    int k = sizeof(tmp);
+    unsigned long long u = (v < 0) ? 0ULL - (unsigned long long)v : (unsigned long long)v;
+    do {
+        tmp[--k] = (char)('0' + u % 10);
+        u /= 10;
+    } while (u);
+    if (v < 0) tmp[--k] = '-';
+    memcpy(b->data + b->len, tmp + k, sizeof(tmp) - k);
+    b->len += sizeof(tmp) - k;
+}
+
+void tour_buf_int(Tour_Buffer *b, long long v) {
+    if (!reserve(b, 24)) return;
+    put_int(b, v);
+}
+
+void tour_buf_double(Tour_Buffer *b, double v, int decimales) {
+    char tmp[64];
+    int l = snprintf(tmp, sizeof(tmp), "%.*f", decimales, v);
+    if (l > 0 && (size_t)l < sizeof(tmp)) tour_buf_str(b, tmp);
+}
+
+void tour_buf_cities(Tour_Buffer *b, const int *tour, int n, char sep, int close) {
+    // au plus 11 chiffres + séparateur par ville : une seule réservation
+    if (n <= 0 || !reserve(b, ((size_t)n + 1) * 12)) return;
+    for (int i = 0; i < n; ++i) {
+        put_int(b, tour[i] + 1);
+        if (i + 1 < n || close) b->data[b->len++] = sep;
+    }
+    if (close) put_int(b, tour[0] + 1);
+}
+
+int tour_buf_write_fd(const Tour_Buffer *b, int fd) {
+    if (b->erreur) return -1;
+    size_t fait = 0;
+    while (fait < b->len) {
+        ssize_t w = write(fd, b->data + fait, b->len - fait);
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        fait += (size_t)w;
+    }
+    return 0;
+}
+
+int tour_buf_write_file(const Tour_Buffer *b, const char *filename, int append) {
+    int fd = open(filename, O_WRONLY | O_CREAT | (append ? O_APPEND : O_TRUNC), 0644);
+    if (fd < 0) {
+        perror(filename);
+        return -1;
+    }
+    int r = tour_buf_write_fd(b, fd);
+    if (close(fd) != 0) r = -1;
+    if (r != 0) perror(filename);
+    return r;
+}
+
+Tour_Format tour_format_of(const char *filename) {
+    const char *ext = strrchr(filename, '.');
+    if (!ext) return TOUR_FMT_INCONNU;
+    if (!strcmp(ext, ".csv")) return TOUR_FMT_CSV;
+    if (!strcmp(ext, ".tour")) return TOUR_FMT_TSPLIB;
+    if (!strcmp(ext, ".bin")) return TOUR_FMT_BIN;
+    return TOUR_FMT_INCONNU;
+}
+
+int export_tour_tsplib(const char *filename, const char *name, const char *comment, const int *tour, int n) {
+    Tour_Buffer b;
+    tour_buf_init(&b);
+    tour_buf_str(&b, "NAME : ");
+    tour_buf_str(&b, (name && *name) ? name : "tour");
+    tour_buf_str(&b, ".tour\n");
+    if (comment) {
+        tour_buf_str(&b, "COMMENT : ");
+        tour_buf_str(&b, comment);
+        tour_buf_str(&b, "\n");
+    }
+    tour_buf_str(&b, "TYPE : TOUR\nDIMENSION : ");
+    tour_buf_int(&b, n);
+    tour_buf_str(&b, "\nTOUR_SECTION\n");
+    tour_buf_cities(&b, tour, n, '\n', 0);
+    tour_buf_str(&b, "\n-1\nEOF\n");
+    int r = tour_buf_write_file(&b, filename, 0);
+    tour_buf_free(&b);
+    return r;
+}
+
+static void put_u32(unsigned char *p, uint32_t v) {
+    p[0] = (unsigned char)v;
+    p[1] = (unsigned char)(v >> 8);
+    p[2] = (unsigned char)(v >> 16);
+    p[3] = (unsigned char)(v >> 24);
+}
+
+static uint32_t get_u32(const unsigned char *p) {
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+int export_tour_bin(const char *filename, const int *tour, int n) {
+    if (n <= 0) return -1;
+    Tour_Buffer b;
+    tour_buf_init(&b);
+    if (!reserve(&b, 12 + (size_t)n * 4)) return -1;
+    unsigned char *p = (unsigned char *)b.data;
+    memcpy(p, TOUR_BIN_MAGIC, 4);
+    put_u32(p + 4, TOUR_BIN_VERSION);
+    put_u32(p + 8, (uint32_t)n);
+    for (int i = 0; i < n; ++i)
+        put_u32(p + 12 + (size_t)i * 4, (uint32_t)tour[i]);
+    b.len = 12 + (size_t)n * 4;
+    int r = tour_buf_write_file(&b, filename, 0);
+    tour_buf_free(&b);
+    return r;
+}
+
+int *import_tour_bin(const char *filename, int *n) {
+    FILE *fp = fopen(filename, "rb");
+    if (!fp) return NULL;
+    unsigned char h[12];
+    int *tour = NULL;
+    if (fread(h, 1, 12, fp) == 12 && !memcmp(h, TOUR_BIN_MAGIC, 4) && get_u32(h + 4) == TOUR_BIN_VERSION) {
+        uint32_t m = get_u32(h + 8);
+        unsigned char *raw = (m > 0 && m < (1u << 28)) ? malloc((size_t)m * 4) : NULL;
+        tour = raw ? malloc(((size_t)m + 1) * sizeof(int)) : NULL;
+        char *vu = tour ? calloc(m, 1) : NULL;
+        int ok = vu && fread(raw, 4, m, fp) == m;
+        for (uint32_t i = 0; ok && i < m; ++i) {
+            uint32_t v = get_u32(raw + (size_t)i * 4);
+            ok = (v < m && !vu[v]);     // permutation de 0..n-1
+            if (ok) {
+                vu[v] = 1;
+                tour[i] = (int)v;
+            }
+        }
+        if (ok) {
+            tour[m] = tour[0];
+            *n = (int)m;
+        } else {
+            free(tour);
+            tour = NULL;
+        }
+        free(raw);
+        free(vu);
+    }
+    fclose(fp);
+    return tour;
+}
+
+int export_tour(const char *filename, const char *name, const char *comment, const int *tour, int n) {
+    switch (tour_format_of(filename)) {
+    case TOUR_FMT_CSV:    return export_tour_csv(filename, tour, n);
+    case TOUR_FMT_TSPLIB: return export_tour_tsplib(filename, name, comment, tour, n);
+    case TOUR_FMT_BIN:    return export_tour_bin(filename, tour, n);
+    default:
+        fprintf(stderr, "%s : extension inconnue (.csv, .tour ou .bin)\n", filename);
+        return -1;
+    }
+}
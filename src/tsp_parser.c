@@ -6,6 +6,7 @@
 #include "tsp_types.h"
 #include "distance.h"
 #include "tsp_parser.h"
+#include "stats.h"
 
 #define MAX_LINE_LENGTH 512
 #define MAX_KEY_LENGTH   64
@@ -91,7 +92,8 @@ static int line_starts_with(const char *line, const char *prefix) {
 //   Parsing principal
 // ---------------------------------------------------------------------
 
-TSP_Instance *tsp_read_file(const char *filename) {
+TSP_Instance *tsp_read_coords(const char *filename) {
+    double t_parse = stats_begin();
     FILE *file = fopen(filename, "r");
     if (!file) {
         perror("Erreur d’ouverture du fichier TSP");
@@ -191,8 +193,40 @@ TSP_Instance *tsp_read_file(const char *filename) {
         instance->dist_type = DIST_EUC_2D; // Valeur par défaut
     }
 
+    stats_end(STAT_PARSE, t_parse);
+    return instance;
+}
+
+TSP_Instance *tsp_read_file(const char *filename) {
+    TSP_Instance *instance = tsp_read_coords(filename);
     // Calcul des distances
+    if (instance) build_distance_matrix(instance);
+    return instance;
+}
+
+TSP_Instance *tsp_from_coords(const char *name, DistanceType type, int n, const double *x, const double *y) {
+    if (n <= 0 || !x || !y) return NULL;
+
+    TSP_Instance *instance = (TSP_Instance *)calloc(1, sizeof(TSP_Instance));
+    if (!instance) return NULL;
+    strncpy(instance->name, name ? name : "", sizeof(instance->name) - 1);
+    strncpy(instance->type, "TSP", sizeof(instance->type) - 1);
+    instance->dimension = n;
+    instance->dist_type = (type == DIST_UNKNOWN) ? DIST_EUC_2D : type;
+    instance->x = malloc((size_t)n * sizeof(double));
+    instance->y = malloc((size_t)n * sizeof(double));
+    if (!instance->x || !instance->y) {
+        tsp_free_instance(instance);
+        return NULL;
+    }
+    memcpy(instance->x, x, (size_t)n * sizeof(double));
+    memcpy(instance->y, y, (size_t)n * sizeof(double));
+
     build_distance_matrix(instance);
+    if (!instance->dist) {
+        tsp_free_instance(instance);
+        return NULL;
+    }
     return instance;
 }
 
@@ -0,0 +1,61 @@
+/*
+ * Test de l'API incrémentale brute_incr() sur le même problème d’affectation que
+ * bf_test.c : le coût est accumulé personne par personne (aucune allocation), et les
+ * préfixes déjà au moins aussi chers que la meilleure affectation sont élagués.
+ * Seules les permutations complètes atteintes sont affichées avec leur coût (2 des 6
+ * ici), puis la meilleure solution, identique à celle de brute().
+ */
+// Compilation :  gcc tests/bf_incr_test.c src/algo_bf.c src/thread_pool.c -Iinclude -pthread -o tests/bf_incr_test
+// execution :  ./tests/bf_incr_test
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "algo_bf.h"  //  le bon header pour la fonction générique
+#include <signal.h>
+
+#define N 3
+ 
+volatile sig_atomic_t stop_requested = 0;
+
+// Définition de la matrice des coûts [personne][tâche]
+int cost_matrix[N][N] = {
+    {9, 2, 7},
+    {6, 4, 3},
+    {5, 8, 1}
+};
+
+// Coût de l'affectation de la tâche perm[pos] à la personne pos
+static unsigned long long assignment_extend(void *ctx, const int *perm, int pos) {
+    int (*costs)[N] = ctx;
+    return (unsigned long long)costs[pos][perm[pos]];
+}
+
+// Appelé sur chaque permutation complète : rien à ajouter, on affiche
+static unsigned long long assignment_close(void *ctx, const int *perm, int n) {
+    int (*costs)[N] = ctx;
+    unsigned long long cost = 0;
+    for (int i = 0; i < n; ++i)
+        cost += costs[i][perm[i]];
+
+    printf("Permutation testee : ");
+    for (int i = 0; i < n; ++i)
+        printf("%d ", perm[i]);
+    printf("-> Cout : %llu\n", cost);
+
+    return 0;
+}
+
+int main() {
+    int best_perm[N];
+    unsigned long long best_cost;
+
+    BF_Hooks hooks = { assignment_extend, NULL, assignment_close, NULL, NULL };
+    brute_incr(N, 0, best_perm, &best_cost, &hooks, cost_matrix);
+
+    printf("\n Meilleure affectation (personne -> tache) :\n");
+    for (int i = 0; i < N; ++i)
+        printf("  Personne %d -> Tache %d\n", i, best_perm[i]);
+    printf("Cout total : %llu\n", best_cost);
+
+    return 0;
+}
@@ -6,7 +6,7 @@
  * affiche chaque permutation testée avec son coût, puis affiche la meilleure solution.
  * Ce test démontre la généricité de l’algorithme brute-force, sans lien avec le TSP.
  */
-// Compilation :  gcc tests/bf_test.c src/algo_bf.c -Iinclude -o tests/bf_test
+// Compilation :  gcc tests/bf_test.c src/algo_bf.c src/thread_pool.c -Iinclude -pthread -o tests/bf_test
 // execution :  ./tests/bf_test
 
 #include <stdio.h>
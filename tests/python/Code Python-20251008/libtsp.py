@@ -0,0 +1,186 @@
+"""
+Enveloppe ctypes de libtsp.so (make lib, API dans include/libtsp.h)
+Les coordonnées numpy (n, 2) en float64 contigu sont passées par pointeur, sans copie.
+
+    import numpy as np
+    from libtsp import Instance
+    inst = Instance.from_coords(np.random.rand(100, 2) * 1000)
+    tour, longueur = inst.solve("nn2opt")
+    tour, longueur = inst.solve("ga", pop=50, gen=200, mut=0.05, seed=1)
+    tour, longueur = inst.solve("gaeax", pop=50, gen=1000, mut=0.05, deadline=0.2,
+                                progress=lambda l, t: print(f"{t:.3f}s {l:.0f}"))
+"""
+import ctypes
+import os
+
+try:
+    import numpy as np
+except ImportError: # listes Python seulement
+    np = None
+
+_c_double_p = ctypes.POINTER(ctypes.c_double)
+_c_int_p = ctypes.POINTER(ctypes.c_int)
+_Progress = ctypes.CFUNCTYPE(None, ctypes.c_void_p, ctypes.c_double, ctypes.c_double)
+
+def _charger(chemin=None):
+    # LIBTSP : chemin explicite, sinon bin/libtsp.so à la racine du dépôt
+    if chemin is None:
+        chemin = os.environ.get("LIBTSP", os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                                                       "..", "..", "..", "bin", "libtsp.so"))
+    lib = ctypes.CDLL(chemin)
+    lib.libtsp_version.restype = ctypes.c_int
+    lib.libtsp_strerror.argtypes = [ctypes.c_int]
+    lib.libtsp_strerror.restype = ctypes.c_char_p
+    lib.libtsp_load.argtypes = [ctypes.c_char_p]
+    lib.libtsp_load.restype = ctypes.c_void_p
+    lib.libtsp_from_coords.argtypes = [ctypes.c_int, _c_double_p, _c_double_p, ctypes.c_long, ctypes.c_char_p]
+    lib.libtsp_from_coords.restype = ctypes.c_void_p
+    lib.libtsp_free.argtypes = [ctypes.c_void_p]
+    lib.libtsp_free.restype = None
+    lib.libtsp_dimension.argtypes = [ctypes.c_void_p]
+    lib.libtsp_dimension.restype = ctypes.c_int
+    lib.libtsp_distance.argtypes = [ctypes.c_void_p, ctypes.c_int, ctypes.c_int]
+    lib.libtsp_distance.restype = ctypes.c_double
+    lib.libtsp_is_method.argtypes = [ctypes.c_char_p]
+    lib.libtsp_is_method.restype = ctypes.c_int
+    lib.libtsp_solve.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_char_p, _c_int_p, _c_double_p]
+    lib.libtsp_solve.restype = ctypes.c_int
+    lib.libtsp_control_new.argtypes = [ctypes.c_double, _Progress, ctypes.c_void_p]
+    lib.libtsp_control_new.restype = ctypes.c_void_p
+    lib.libtsp_control_cancel.argtypes = [ctypes.c_void_p]
+    lib.libtsp_control_cancel.restype = None
+    lib.libtsp_control_stopped.argtypes = [ctypes.c_void_p]
+    lib.libtsp_control_stopped.restype = ctypes.c_int
+    lib.libtsp_control_free.argtypes = [ctypes.c_void_p]
+    lib.libtsp_control_free.restype = None
+    lib.libtsp_solve_ctl.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_char_p, _c_int_p, _c_double_p,
+                                     ctypes.c_void_p]
+    lib.libtsp_solve_ctl.restype = ctypes.c_int
+    lib.libtsp_tour_length.argtypes = [ctypes.c_void_p, _c_int_p, ctypes.c_int]
+    lib.libtsp_tour_length.restype = ctypes.c_double
+    lib.libtsp_export_csv.argtypes = [ctypes.c_char_p, ctypes.c_void_p, ctypes.c_char_p, ctypes.c_double,
+                                      _c_int_p, ctypes.c_int]
+    lib.libtsp_export_csv.restype = ctypes.c_int
+    lib.libtsp_export_tour.argtypes = [ctypes.c_char_p, ctypes.c_void_p, _c_int_p]
+    lib.libtsp_export_tour.restype = ctypes.c_int
+    return lib
+
+_lib = None
+
+def lib():
+    global _lib
+    if _lib is None:
+        _lib = _charger()
+    return _lib
+
+class TSPError(Exception):
+    pass
+
+def _verifier(code):
+    if code != 0:
+        raise TSPError(lib().libtsp_strerror(code).decode())
+
+def _tour_c(tour, n):
+    # tour numpy int32 contigu : passé tel quel ; sinon copie dans un tableau ctypes
+    if np is not None and isinstance(tour, np.ndarray):
+        t = np.ascontiguousarray(tour, dtype=np.intc)
+        return t, t.ctypes.data_as(_c_int_p)
+    t = (ctypes.c_int * n)(*tour)
+    return t, t
+
+class Control:
+    """Échéance, annulation (depuis un autre thread) et progression d'une résolution"""
+
+    def __init__(self, deadline=None, progress=None):
+        # progress(longueur, temps) : appelé à chaque nouvelle meilleure tournée
+        self._cb = _Progress(lambda user, l, t: progress(l, t)) if progress else _Progress()
+        self._h = lib().libtsp_control_new(deadline or 0.0, self._cb, None)
+        if not self._h:
+            raise TSPError("création du contrôle impossible")
+
+    def cancel(self):
+        lib().libtsp_control_cancel(self._h)
+
+    @property
+    def stopped(self):
+        # vrai si la dernière résolution a été écourtée
+        return bool(lib().libtsp_control_stopped(self._h))
+
+    def __del__(self):
+        if getattr(self, "_h", None) and _lib is not None:
+            _lib.libtsp_control_free(self._h)
+            self._h = None
+
+class Instance:
+    """Instance TSP (coordonnées et matrice des distances) côté C, libérée avec l'objet"""
+
+    def __init__(self, handle):
+        if not handle:
+            raise TSPError("création de l'instance impossible")
+        self._h = handle
+        self.n = lib().libtsp_dimension(handle)
+
+    @classmethod
+    def load(cls, filename):
+        return cls(lib().libtsp_load(filename.encode()))
+
+    @classmethod
+    def from_coords(cls, coords, dist_type="EUC_2D"):
+        # coords : tableau (n, 2) ou liste de couples (x, y)
+        if np is not None:
+            a = np.ascontiguousarray(coords, dtype=np.float64) # pas de copie si déjà float64 contigu
+            if a.ndim != 2 or a.shape[1] != 2:
+                raise TSPError("coordonnées attendues sous la forme (n, 2)")
+            base = a.ctypes.data
+            x = ctypes.cast(base, _c_double_p)
+            y = ctypes.cast(base + a.itemsize, _c_double_p)
+            return cls(lib().libtsp_from_coords(a.shape[0], x, y, 2, dist_type.encode()))
+        n = len(coords)
+        x = (ctypes.c_double * n)(*[c[0] for c in coords])
+        y = (ctypes.c_double * n)(*[c[1] for c in coords])
+        return cls(lib().libtsp_from_coords(n, x, y, 1, dist_type.encode()))
+
+    def __del__(self):
+        if getattr(self, "_h", None) and _lib is not None:
+            _lib.libtsp_free(self._h)
+            self._h = None
+
+    def distance(self, i, j):
+        return lib().libtsp_distance(self._h, i, j)
+
+    def solve(self, method, deadline=None, progress=None, control=None, **params):
+        # params : pop gen mut mt seed samples budget starts k threads stagnation
+        # deadline (secondes) et progress(longueur, temps) : raccourcis pour un Control
+        # retourne (tournée de n villes numérotées à partir de 0, longueur)
+        if control is None and (deadline or progress):
+            control = Control(deadline, progress)
+        txt = " ".join(f"{k}={v}" for k, v in params.items()).encode()
+        longueur = ctypes.c_double()
+        if np is not None:
+            tour = np.empty(self.n, dtype=np.intc)
+            ptr = tour.ctypes.data_as(_c_int_p)
+        else:
+            tour = (ctypes.c_int * self.n)()
+            ptr = tour
+        _verifier(lib().libtsp_solve_ctl(self._h, method.encode(), txt, ptr, ctypes.byref(longueur),
+                                         control._h if control else None))
+        return (tour if np is not None else list(tour)), longueur.value
+
+    def tour_length(self, tour):
+        # -1 si tour n'est pas une permutation de 0..n-1
+        _, ptr = _tour_c(tour, len(tour))
+        return lib().libtsp_tour_length(self._h, ptr, len(tour))
+
+    def export_tour(self, filename, tour):
+        # format selon l'extension : .tour (TSPLIB), .csv ou .bin
+        t, ptr = _tour_c(tour, self.n)
+        if len(tour) != self.n:
+            raise TSPError("la tournée doit contenir n villes")
+        _verifier(lib().libtsp_export_tour(filename.encode(), self._h, ptr))
+
+    def export_csv(self, filename, method, tour, duration=0.0, entete=False):
+        t, ptr = _tour_c(tour, self.n)
+        if len(tour) != self.n:
+            raise TSPError("la tournée doit contenir n villes")
+        _verifier(lib().libtsp_export_csv(filename.encode(), self._h, method.encode(), duration, ptr,
+                                          1 if entete else 0))
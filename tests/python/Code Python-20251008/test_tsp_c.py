@@ -38,6 +38,23 @@ def extract_data(path,code,filename,method,distance_fct,coord,graphique):
     except Exception as e:
         print(f"Erreur (Python) e = {e} lst = {lst}")
 
+def extract_data_lib(filename,method,distance_fct,coord,graphique,**params):
+    # même test sans sous-processus : appel direct de libtsp.so (make lib) via ctypes
+    import libtsp
+    inst = libtsp.Instance.load(filename)
+    t0 = time.time()
+    try:
+        tour,length = inst.solve(method,**params)
+    except libtsp.TSPError as e:
+        print(f"Erreur (libtsp) e = {e}")
+        return
+    tps = time.time()-t0
+    tour = [int(v)+1 for v in tour]+[int(tour[0])+1] # numérotation TSPLIB, retour au départ
+    l = fitness(tour,distance_fct,coord)
+    v = valid(tour)
+    print(f"{filename} ; {method} ; {int(length)} ; {l} ; {tps} ; {tour} ; {v==0} ; {l==length}")
+    graphique(tour,method,coord)
+
 def load_instance(filename):
     # utilise fcts tsplib95
     instance = load_tsp_file(filename)
@@ -48,8 +65,8 @@ def load_instance(filename):
     edge_type = instance_dict['edge_weight_type']
     return instance,coord,edge_type
 
-def test_instance(filename,methods):
-    # affiche la banière des résultats et appelle les programme C
+def test_instance(filename,methods,lib_methods=()):
+    # affiche la banière des résultats et appelle les programme C, puis libtsp.so
     instance,coord,edge_type = load_instance(filename)
     distance_fct,graphique = select_fct(edge_type)
 
@@ -60,13 +77,15 @@ def test_instance(filename,methods):
 
     for m in methods:
         extract_data(path,code,filename,m,distance_fct,coord,graphique) # l'exécutable C s'appelle tsp dans mon cas.
+    for m,params in lib_methods:
+        extract_data_lib(filename,m,distance_fct,coord,graphique,**params)
 
-def tests_instances_list(instances_file,methods):
-    # lance le programme C avec toutes les options de methods
+def tests_instances_list(instances_file,methods,lib_methods=()):
+    # lance le programme C avec toutes les options de methods (et libtsp.so avec lib_methods)
     # et tous les fichiers d'instance de instance_file 
     with open(instances_file, 'r') as file:
         for instance in file:
-            test_instance(instance.strip(),methods)
+            test_instance(instance.strip(),methods,lib_methods)
 
 # Liste de paramètres.
 # opt = tsplib95.load_solution(filename+'.opt.tour') pour charger un fichier solution dans python
@@ -75,6 +94,7 @@ filename = "att48.tsp" #
 path = "../Code_C/" # adaptez à votre cas
 code = "tsp" # nom du programme C
 methods = ["-c","nn","rw","2optnn","2optrw","ga 10000 0.10 100"]#"bf","gadpx"
+lib_methods = [("nn",{}),("nn2opt",{}),("ga",{"pop":100,"gen":1000,"mut":0.10})] # via libtsp.so (make lib), [] sans la bibliothèque
 
 #test_instance(filename,methods) # pour un seul appel
-tests_instances_list("instances.txt",methods) # marche si le C marche
+tests_instances_list("instances.txt",methods,lib_methods) # marche si le C marche